@@ -16,6 +16,11 @@
 
     #include "qtypes.h"
     #include "qlists.h"
+    #include "qhashmaps.h"
+    #include "qtrees.h"
+    #include "qmpsc.h"
+    #include "qmpmc.h"
+    #include "qmailbox.h"
     #include "qkernel.h"
     #include "qtasks.h"    
     #include "qcoroutine.h"
@@ -42,6 +47,10 @@
         #include "qbsbuffers.h"
     #endif
 
+    #if ( Q_REPLAY == 1 )
+        #include "qreplay.h"
+    #endif
+
     #include "qbitmacros.h"
 
 
@@ -65,6 +74,30 @@
         #error Q_PRIO_QUEUE_SIZE should be a value greater of equal than zero.
     #endif
 
+    #if ( ( Q_QUEUE_SET_SIZE < 0 ) || ( Q_QUEUE_SET_SIZE > 32 ) )
+        #error Q_QUEUE_SET_SIZE value not allowed, use a value between 0 and 32.
+    #endif
+
+    #if ( Q_TASK_POOL_SIZE < 0 )   
+        #error Q_TASK_POOL_SIZE should be a value greater of equal than zero.
+    #endif
+
+    #if ( ( Q_TASK_REGISTRY == 1 ) && ( ( Q_TASK_REGISTRY_BUCKETS < 1 ) || ( 0 != ( Q_TASK_REGISTRY_BUCKETS & ( Q_TASK_REGISTRY_BUCKETS - 1 ) ) ) ) )
+        #error Q_TASK_REGISTRY_BUCKETS must be a power of two.
+    #endif
+
+    #if ( Q_CACHE_LINE_SIZE < 16 )
+        #error Q_CACHE_LINE_SIZE it is too small. Min(16).
+    #endif
+
+    #if ( ( Q_LIST_INDEX_LEVELS < 0 ) || ( Q_LIST_INDEX_LEVELS > 15 ) )
+        #error Q_LIST_INDEX_LEVELS value not allowed, use a value between 0 and 15.
+    #endif
+
+    #if ( ( Q_REPLAY == 1 ) && ( ( Q_REPLAY_OBJECTS < 1 ) || ( Q_REPLAY_MAX_ITEM_SIZE < 1 ) ) )
+        #error Q_REPLAY_OBJECTS and Q_REPLAY_MAX_ITEM_SIZE should be greater than zero.
+    #endif
+
 
     #include "qbackward.h"
 
@@ -3,6 +3,9 @@
     #define QBSBUFFERS_H
 
     #include "qtypes.h"
+    #include "qcritical.h"
+
+    #include <string.h>
 
     #ifdef __cplusplus
     extern "C" {
@@ -22,7 +25,16 @@
 
     qBool_t qBSBuffer_Get( qBSBuffer_t * const obj, qUINT8_t *dest );
     qBool_t qBSBuffer_Read( qBSBuffer_t * const obj, void *dest, const size_t n );
+    size_t qBSBuffer_ReadUpTo( qBSBuffer_t * const obj, void *dest, const size_t n );
     qBool_t qBSBuffer_Put( qBSBuffer_t * const obj, const qUINT8_t data );
+    qBool_t qBSBuffer_Write( qBSBuffer_t * const obj, const void *src, const size_t n );
+    size_t qBSBuffer_WriteUpTo( qBSBuffer_t * const obj, const void *src, const size_t n );
+
+    /*Zero-copy access (i.e. for DMA transfers)*/
+    void* qBSBuffer_GetWriteSpan( const qBSBuffer_t * const obj, size_t * const size );
+    qBool_t qBSBuffer_CommitWrite( qBSBuffer_t * const obj, const size_t n );
+    void* qBSBuffer_GetReadSpan( const qBSBuffer_t * const obj, size_t * const size );
+    qBool_t qBSBuffer_ConsumeRead( qBSBuffer_t * const obj, const size_t n );
     void qBSBuffer_Init( qBSBuffer_t * const obj, volatile qUINT8_t *buffer, const size_t length );
 
     #ifdef __cplusplus
@@ -0,0 +1,60 @@
+/*This file is part of the QuarkTS distribution.*/
+#ifndef QCHANNELS_H
+    #define QCHANNELS_H
+
+    #include "qtypes.h"
+    #include "qcritical.h"
+
+    #include <string.h>
+
+    #ifdef __cplusplus
+    extern "C" {
+    #endif
+
+    typedef void (*qChannelWakeupFcn_t)( void *arg );
+
+    /*
+    A channel is a lock-free ring of fixed-size items with exactly one producer
+    and one consumer that can run in different execution contexts (threads,
+    cores or ISRs). Each index is written only by one side, so no critical
+    sections are required.
+    */
+    typedef struct{
+        private_start{
+            qUINT8_t *Storage;              /*< Points to the beginning of the channel storage area. */
+            size_t ItemSize;                /*< The size of each item that the channel will hold. */
+            size_t ItemsCount;              /*< The capacity of the channel defined as the number of items it will hold. */
+            volatile size_t Head;           /*< Write index in the range [0, 2*ItemsCount). Only modified by the producer. */
+            volatile size_t Tail;           /*< Read index in the range [0, 2*ItemsCount). Only modified by the consumer. */
+            qChannelWakeupFcn_t Wakeup;     /*< The function used to wake up the consumer after a send operation. */
+            void *WakeupArg;                /*< The argument passed to the wake-up function. */
+        }private_end;
+    }qChannel_t;
+
+    qBool_t qChannelCreate( qChannel_t * const obj, void *DataArea, size_t ItemSize, size_t ItemsCount );
+    void qChannelSetWakeup( qChannel_t * const obj, qChannelWakeupFcn_t Wakeup, void *arg );
+    size_t qChannelCount( const qChannel_t * const obj );
+    qBool_t qChannelIsEmpty( const qChannel_t * const obj );
+    qBool_t qChannelIsFull( const qChannel_t * const obj );
+
+    /*Producer side*/
+    qBool_t qChannelSendToBack( qChannel_t * const obj, const void *ItemToSend );
+    size_t qChannelSendN( qChannel_t * const obj, const void *Items, size_t n );
+    /*qBool_t qChannelSend(qChannel_t *obj, void *ItemToSend)
+
+    Post an item to the back of the channel. The item is sent by copy, not by reference.
+    See qChannelSendToBack.
+    */
+    #define qChannelSend( _qChannel_t_, _ItemToSend_ )     qChannelSendToBack( (_qChannel_t_), (_ItemToSend_) )
+
+    /*Consumer side*/
+    void* qChannelPeek( const qChannel_t * const obj );
+    qBool_t qChannelRemoveFront( qChannel_t * const obj );
+    qBool_t qChannelReceive( qChannel_t * const obj, void *dest );
+    size_t qChannelReceiveN( qChannel_t * const obj, void *dest, size_t n );
+
+    #ifdef __cplusplus
+    }
+    #endif
+
+#endif
@@ -35,6 +35,10 @@
     qClock_t qClock_GetTick( void );
     qBool_t qClock_TimeDeadlineCheck( const qClock_t ti, const qClock_t td );
 
+    #if ( Q_REPLAY == 1 )
+        qClock_t __qPrivate_ReplayTick( const qClock_t Tick ); /*This function is not intended for the user usage*/
+    #endif
+
     #ifdef __cplusplus
     }
     #endif
@@ -8,17 +8,32 @@
     #define Q_SETUP_TICK_IN_HERTZ       ( 0 )       /*< If enabled, the timming base will be taken as frequency(Hz) instead of period(S)*/
     #define Q_PRIO_QUEUE_SIZE           ( 10 )      /*< The size of the priority queue (use a 0(zero) value to disable it)*/    
     #define Q_PRESERVE_TASK_ENTRY_ORDER ( 0 )       /*< If enabled, kernel will preserve the tasks entry order every OS scheduling cycle*/
+    #define Q_TASK_POOL_SIZE            ( 0 )       /*< The number of task objects available for qSchedulerCreateTask (use a 0(zero) value to disable it)*/
+    #define Q_TASK_REGISTRY             ( 0 )       /*< Used to enable or disable the task registry (task names and IDs with hashed lookup)*/
+    #define Q_TASK_REGISTRY_BUCKETS     ( 16 )      /*< The number of buckets of the task registry maps (power of two)*/
+    #define Q_LIST_POOLS                ( 0 )       /*< Used to enable or disable the fixed-size node pools for the dynamic list operations*/
+    #define Q_LIST_INDEX_LEVELS         ( 0 )       /*< The number of skip-list levels stored in the nodes of an indexed list, each one allows 4x more nodes (use a 0(zero) value to disable it)*/
     #define Q_MEMORY_MANAGER            ( 1 )       /*< Used to enable or disable the Memory Manager*/
     #define Q_BYTE_ALIGNMENT            ( 8 )       /*< Byte alignment used by the memory manager*/
     #define Q_DEFAULT_HEAP_SIZE         ( 2048  )   /*< The default heap size for the memory manager*/    
     #define Q_NOTIFICATION_SPREADER     ( 1 )       /*< Used to enable or disable the spread notification functionality*/ 
     #define Q_FSM                       ( 1 )       /*< Used to enable or disable the Finite State Machine (FSM) module */
     #define Q_QUEUES                    ( 1 )       /*< Used to enable or disable the qQueues*/
+    #define Q_QUEUE_STATS               ( 0 )       /*< Used to enable or disable the queue statistics (occupancy, failures and latency)*/
+    #define Q_QUEUE_SET_SIZE            ( 0 )       /*< The max number of queues in a queue set, up to 32 (use a 0(zero) value to disable the queue sets)*/
+    #define Q_CHANNELS                  ( 0 )       /*< Used to enable or disable the lock-free single-producer/single-consumer channels*/
+    #define Q_ATOMIC_CAS                ( 1 )       /*< Use the compare-and-swap builtins of the compiler in the lock-free objects (disable it on cores without CAS to use critical sections instead)*/
+    #define Q_CACHE_LINE_SIZE           ( 64 )      /*< The cache line size used to pad the indexes of the multi-producer/multi-consumer rings*/
     #define Q_TRACE_VARIABLES           ( 1 )       /*< Used to enable or disable variable tracing and debuggin*/
     #define Q_DEBUGTRACE_BUFSIZE        ( 36 )      /*< Size for the debug/trace buffer: 36 bytes should be enough*/
     #define Q_DEBUGTRACE_FULL           ( 1 )       /*< Used to enable or disable a full trace output*/
     #define Q_ATCOMMAND_PARSER          ( 1 )       /*< Used to enable or disable the AT Command parser module for CLI*/
     #define Q_TASK_COUNT_CYCLES         ( 1 )       /*< Used to enable or disable the task cycles counter*/
+    #define Q_SCHEDULER_LOAD            ( 0 )       /*< Used to enable or disable the CPU load measurement*/
+    #define Q_SCHEDULER_LOAD_WINDOW     ( 1000uL )  /*< The default length of the load measurement window (in counts of the load counter)*/
+    #define Q_REPLAY                    ( 0 )       /*< Used to enable or disable the deterministic record/replay of the kernel inputs*/
+    #define Q_REPLAY_OBJECTS            ( 16 )      /*< The max number of objects (tasks, queues, event-data) that can be referenced from the record/replay stream*/
+    #define Q_REPLAY_MAX_ITEM_SIZE      ( 16 )      /*< The max size (in bytes) of a queue item that can be recorded*/
     #define Q_MAX_FTOA_PRECISION        ( 10u )     /*< default qFtoA precision*/
     #define Q_ATOF_FULL                 ( 0 )       /*< Used to enable or disablethe extended "e" notation parsing in qAtoF*/
     #define Q_ALLOW_SCHEDULER_RELEASE   ( 1 )       /*< Used to enable or disable the release of the scheduling */
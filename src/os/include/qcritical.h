@@ -15,6 +15,51 @@
     void qCritical_Exit( void );
     void qCritical_SetInterruptsED( const qInt_Restorer_t Restorer, const qInt_Disabler_t Disabler );
 
+    /*qCritical_MemoryBarrier()
+
+    Full memory barrier. Prevents the compiler and the CPU from reordering
+    memory accesses across this point. Used by the lock-free objects to 
+    publish data between a single producer and a single consumer.
+    When the compiler is not recognized, an external call is used instead,
+    that acts as a compiler barrier (enough for single core devices).
+    */
+    #if defined( __GNUC__ ) || defined( __clang__ )
+        #define qCritical_MemoryBarrier()   __sync_synchronize()
+    #elif defined( __STDC_VERSION__ ) && ( __STDC_VERSION__ >= 201112L ) && !defined( __STDC_NO_ATOMICS__ )
+        #include <stdatomic.h>
+        #define qCritical_MemoryBarrier()   atomic_thread_fence( memory_order_seq_cst )
+    #else
+        #define qCritical_MemoryBarrier()   __qCritical_CompilerBarrier()
+    #endif
+    void __qCritical_CompilerBarrier( void ); /*This function is not intended for the user usage*/
+
+    /*qCritical_CompareAndSwap( void * volatile *ptr, void *expected, void *desired )
+
+    Atomically replace the pointer at <ptr> with <desired> only if it still
+    holds <expected>. Returns qTrue if the pointer was replaced. Implies a
+    full memory barrier.
+    Uses the compare-and-swap builtins of the compiler when Q_ATOMIC_CAS is
+    enabled, otherwise (or if the compiler is not recognized) the operation
+    is performed inside a critical section.
+    */
+    #if ( Q_ATOMIC_CAS == 1 ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+        #define qCritical_CompareAndSwap( ptr, expected, desired )      ( ( __sync_bool_compare_and_swap( (ptr), (expected), (desired) ) )? qTrue : qFalse )
+    #else
+        #define qCritical_CompareAndSwap( ptr, expected, desired )      __qCritical_CompareAndSwap( (ptr), (expected), (desired) )
+    #endif
+    qBool_t __qCritical_CompareAndSwap( void * volatile *ptr, void *expected, void *desired ); /*This function is not intended for the user usage*/
+
+    /*qCritical_CompareAndSwapSize( volatile size_t *ptr, size_t expected, size_t desired )
+
+    Same as qCritical_CompareAndSwap, for size_t values.
+    */
+    #if ( Q_ATOMIC_CAS == 1 ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+        #define qCritical_CompareAndSwapSize( ptr, expected, desired )  ( ( __sync_bool_compare_and_swap( (ptr), (expected), (desired) ) )? qTrue : qFalse )
+    #else
+        #define qCritical_CompareAndSwapSize( ptr, expected, desired )  __qCritical_CompareAndSwapSize( (ptr), (expected), (desired) )
+    #endif
+    qBool_t __qCritical_CompareAndSwapSize( volatile size_t *ptr, size_t expected, size_t desired ); /*This function is not intended for the user usage*/
+
     #ifdef __cplusplus
     }
     #endif
@@ -0,0 +1,91 @@
+/*This file is part of the QuarkTS distribution.*/
+#ifndef QHASHMAPS_H
+    #define QHASHMAPS_H
+
+    #include "qtypes.h"
+    #include "qlists.h"
+    #include <stddef.h>
+
+    #ifdef __cplusplus
+    extern "C" {
+    #endif
+
+    /*
+    Intrusive hash map. Like the nodes of a qList_t, the nodes of a map are
+    user structures that embed the qHashNode_MinimalFields header, so the map
+    never allocates memory:
+
+        typedef struct{
+            qHashNode_MinimalFields;
+            qUINT32_t SessionID;
+            ...
+        }Session_t;
+
+    The buckets are an array of pointers supplied by the application. Each
+    bucket holds a chain of the nodes whose hash maps to it. The map can be
+    moved to a larger (or smaller) bucket array with qHashMap_Resize. The
+    nodes are migrated a few buckets at a time on every subsequent insert
+    or removal, so no single call pays for the whole rehash. Lookups never
+    modify the map.
+
+    If the header can't be the first member of the structure, embed a
+    qHashNode_t member instead, pass its address to the qHashMap_* functions
+    and get back the structure with qHashMap_Entry.
+    */
+    #define qHashNode_MinimalFields     void *__qHashNext, *__qHashContainer; const void *__qHashKey; size_t __qHashValue
+
+    typedef struct{
+        qHashNode_MinimalFields;
+    }qHashNode_t;
+
+    typedef size_t (*qHashFcn_t)( const void *key );
+    typedef qBool_t (*qHashEqualFcn_t)( const void *key1, const void *key2 );
+
+    typedef struct{
+        private_start{
+            void **Buckets;             /*< The current bucket array. */
+            void **OldBuckets;          /*< The bucket array being migrated (NULL when no resize is in progress). */
+            size_t BucketCount;         /*< The number of buckets in the current array (power of two). */
+            size_t OldBucketCount;      /*< The number of buckets in the array being migrated. */
+            size_t MigrateIndex;        /*< The next old bucket to migrate. */
+            size_t Count;               /*< The number of nodes in the map. */
+            size_t Walking;             /*< The number of walks in progress. The migration is suspended meanwhile. */
+            qHashFcn_t HashFcn;         /*< The function that computes the hash of a key. */
+            qHashEqualFcn_t EqualFcn;   /*< The function that compares two keys. */
+        }private_end;
+    }qHashMap_t;
+
+    /*type* qHashMap_Entry( void *node, type, member )
+
+    Returns a pointer to the structure of type <type> that embeds the
+    qHashNode_t <member> pointed by <node>.
+    */
+    #define qHashMap_Entry( node, type, member )    ( (type*)( (void*)( (qUINT8_t*)(node) - offsetof( type, member ) ) ) )
+    /*const void* qHashMap_Key( void *node )
+
+    Returns the key of a node that belongs to a map.
+    */
+    #define qHashMap_Key( node )                    ( ( (qHashNode_t*)(node) )->__qHashKey )
+
+    qBool_t qHashMap_Setup( qHashMap_t * const map, void **Buckets, const size_t BucketCount, const qHashFcn_t HashFcn, const qHashEqualFcn_t EqualFcn );
+    qBool_t qHashMap_Insert( qHashMap_t * const map, void * const node, const void *key );
+    void* qHashMap_Find( const qHashMap_t * const map, const void *key );
+    qBool_t qHashMap_Remove( qHashMap_t * const map, void * const node );
+    void* qHashMap_RemoveKey( qHashMap_t * const map, const void *key );
+    size_t qHashMap_Count( const qHashMap_t * const map );
+    size_t qHashMap_BucketCount( const qHashMap_t * const map );
+    qBool_t qHashMap_Resize( qHashMap_t * const map, void **Buckets, const size_t BucketCount );
+    qBool_t qHashMap_Rehash( qHashMap_t * const map, size_t steps );
+    qBool_t qHashMap_IsResizing( const qHashMap_t * const map );
+    qBool_t qHashMap_ForEach( qHashMap_t * const map, const qListNodeFcn_t Fcn, void *arg );
+
+    size_t qHashMap_StringHash( const void *key );
+    qBool_t qHashMap_StringEqual( const void *key1, const void *key2 );
+    size_t qHashMap_U32Hash( const void *key );
+    qBool_t qHashMap_U32Equal( const void *key1, const void *key2 );
+
+    #ifdef __cplusplus
+    }
+    #endif
+
+#endif
@@ -0,0 +1,95 @@
+/*This file is part of the QuarkTS distribution.*/
+#ifndef QHOOKS_H
+    #define QHOOKS_H
+
+    #include "qtypes.h"
+
+    /*
+    Scheduler hook points.
+
+    Every hook is a macro that expands to nothing unless the application
+    defines it before this file is included (i.e. inside qconfig.h). This
+    way, instrumentation like profilers, tracers or power-management code
+    can be attached to the kernel without any run-time cost when unused.
+
+    Example (in qconfig.h):
+
+        void Profiler_Enter( void *Task );
+        #define qHook_PreDispatch( Task, e )    Profiler_Enter( (Task) )
+
+    Note: Hooks run in the same context as the code that invokes them, keep
+          them short and never call scheduler APIs that modify the lists.
+    */
+
+    /*qHook_PreDispatch( qTask_t *Task, qEvent_t e )
+
+    Invoked right before the task callback is launched. <e> contains the
+    event info that will be passed to the callback.
+    */
+    #ifndef qHook_PreDispatch
+        #define qHook_PreDispatch( Task, e )
+    #endif
+
+    /*qHook_PostDispatch( qTask_t *Task, qEvent_t e )
+
+    Invoked right after the task callback returns.
+    */
+    #ifndef qHook_PostDispatch
+        #define qHook_PostDispatch( Task, e )
+    #endif
+
+    /*qHook_TriggerDetected( qTask_t *Task, qTrigger_t Trigger )
+
+    Invoked when the scheduler detects an event that puts the task in
+    the qReady state.
+    */
+    #ifndef qHook_TriggerDetected
+        #define qHook_TriggerDetected( Task, Trigger )
+    #endif
+
+    /*qHook_IdleEnter()
+
+    Invoked when a scheduling cycle finds no ready tasks, before the idle
+    callback (if available) is launched.
+    */
+    #ifndef qHook_IdleEnter
+        #define qHook_IdleEnter()
+    #endif
+
+    /*qHook_IdleExit()
+
+    Invoked when the idle activities of the scheduling cycle have finished.
+    */
+    #ifndef qHook_IdleExit
+        #define qHook_IdleExit()
+    #endif
+
+    /*qHook_QueueOverflow( qQueue_t *Queue, void *ItemToQueue )
+
+    Invoked when an item can not be sent to a qQueue because it is full.
+    */
+    #ifndef qHook_QueueOverflow
+        #define qHook_QueueOverflow( Queue, ItemToQueue )
+    #endif
+
+    /*qHook_QueueReleaseMismatch( qQueue_t *Queue, void *Slot )
+
+    Invoked when qQueueRelease gets a slot that is not the one held with 
+    qQueuePeekSlot, or when the held item is no longer at the front of the
+    queue (i.e. it was removed or the queue was reset while the slot was 
+    held). The item is not consumed.
+    */
+    #ifndef qHook_QueueReleaseMismatch
+        #define qHook_QueueReleaseMismatch( Queue, Slot )
+    #endif
+
+    /*qHook_NotificationQueueOverflow( qTask_t *Task, void *eventdata )
+
+    Invoked when a queued notification is rejected because the priority
+    queue is full.
+    */
+    #ifndef qHook_NotificationQueueOverflow
+        #define qHook_NotificationQueueOverflow( Task, eventdata )
+    #endif
+
+#endif
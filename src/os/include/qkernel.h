@@ -5,6 +5,7 @@
     #include "qtypes.h"
     #include "qcritical.h"
     #include "qtasks.h"
+    #include "qhooks.h"
    
     #ifdef __cplusplus
     extern "C" {
@@ -29,6 +30,15 @@
 
     typedef qBool_t (*qTaskNotifyMode_t)(qTask_t* arg1, void* arg2);
 
+    #if ( Q_SCHEDULER_LOAD == 1 )
+        typedef struct{
+            qUINT16_t System;       /*< Everything except the idle cycles (per-mille). */
+            qUINT16_t Tasks;        /*< Time spent in the task callbacks (per-mille). */
+            qUINT16_t Idle;         /*< Time spent in cycles that dispatched no task, idle callback included (per-mille). */
+            qUINT16_t Overhead;     /*< Time spent by the scheduler itself: readiness checks and list management (per-mille). */
+        }qLoad_t;
+    #endif
+
     #if (Q_SETUP_TIME_CANONICAL == 1)
         void qSchedulerSetup( const qGetTickFcn_t TickProvider, qTaskFcn_t IdleCallback );
     #else
@@ -57,6 +67,10 @@
     #endif
 
     qBool_t qSchedulerRemoveTask( qTask_t * const Task );
+    #if ( Q_TASK_POOL_SIZE > 0 )
+        qTask_t* qSchedulerCreateTask( qTaskFcn_t CallbackFcn, qPriority_t Priority, qTime_t Time, qIteration_t nExecutions, qState_t InitialState, void* arg );
+        qBool_t qSchedulerDestroyTask( qTask_t * const Task );
+    #endif
     void qSchedulerRun( void );
     #if ( Q_PRIO_QUEUE_SIZE > 0 )  
         qBool_t _qScheduler_PriorityQueue_Insert(qTask_t * const Task, void *data);
@@ -66,6 +80,18 @@
 
     qStateGlobal_t qScheduler_GetTaskGlobalState( const qTask_t * const Task);
 
+    #if ( Q_TASK_REGISTRY == 1 )
+        qTask_t* qSchedulerFindTask( const char *Name );
+        qTask_t* qSchedulerFindTaskByID( const qUINT32_t ID );
+        qBool_t qSchedulerForEachTask( const qListNodeFcn_t Fcn, void *arg );
+        qBool_t _qScheduler_RegistryRename( qTask_t * const Task, const char *Name );
+    #endif
+
+    #if ( Q_SCHEDULER_LOAD == 1 )
+        void qSchedulerSetLoadCounter( const qGetTickFcn_t Counter, const qClock_t Window );
+        qUINT16_t qSchedulerGetLoad( qLoad_t * const Detail );
+    #endif
+
     #ifdef __cplusplus
     }
     #endif
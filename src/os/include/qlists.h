@@ -19,13 +19,34 @@
     #define qNode_MinimalFields     void __qNodeMembers
     #define qNode_MinimalMembers    qNode_MinimalFields
 
+    #if ( Q_LIST_POOLS == 1 )
+        typedef struct qListPool_s{
+            private_start{
+                void *FreeList;                             /*< The first free block. Each free block holds a pointer to the next one. */
+                void* (*Allocator)( size_t size );          /*< The backing arena used to grow the pool. */
+                size_t BlockSize;                           /*< The size of each block (aligned). */
+                size_t GrowCount;                           /*< The number of blocks requested to the arena on every grow. */
+                size_t Capacity;                            /*< The total number of blocks. */
+                size_t Used;                                /*< The number of blocks in use. */
+                size_t HighWater;                           /*< The max number of blocks used at the same time. */
+            }private_end;
+        }qListPool_t;
+    #endif
+
     typedef struct{
         qNode_MinimalFields;        /*< to allow list of lists*/
         qNode_t *head, *tail;       /*< Pointers to the beginning of and the end of the list. */
         size_t size;                /*< Used to hold the current size of the list. */
+        #if ( Q_LIST_POOLS == 1 )
+            qListPool_t *pool;      /*< The pool used by qList_DInsert/qList_DRemove (NULL to use the qList_SetMemoryAllocation functions). */
+        #endif
     }qList_t;
 
-    #define QLIST_INITIALIZER   { NULL, NULL, NULL, NULL, NULL, 0u }
+    #if ( Q_LIST_POOLS == 1 )
+        #define QLIST_INITIALIZER   { NULL, NULL, NULL, NULL, NULL, 0u, NULL }
+    #else
+        #define QLIST_INITIALIZER   { NULL, NULL, NULL, NULL, NULL, 0u }
+    #endif
 
     typedef enum{ qList_WalkInit, qList_WalkThrough, qList_WalkEnd }qList_WalkStage_t;
     #define QLIST_WALKINIT          ( qList_WalkInit )      /*< When the loop is about to start. In this case, A NULL value will be pased in the node pointer*/
@@ -33,6 +54,7 @@
     #define QLIST_WALKEND           ( qList_WalkEnd )       /*< When the loop has finished. In this case, A NULL value will be passed in the node pointer*/
 
     typedef qBool_t (*qListNodeFcn_t)(void *node, void *arg, qList_WalkStage_t stage );
+    typedef qBool_t (*qListCompareFcn_t)(const void *n1, const void *n2);
     typedef qINT32_t qListPosition_t;
 
     typedef void* (*qListMemAllocator_t)( size_t size );
@@ -50,12 +72,15 @@
     qBool_t qList_RemoveItself( void *const node );
     void* qList_Remove( qList_t * const list, void * const node, const qListPosition_t position );
     qBool_t qList_Move( qList_t *const destination, qList_t *const source, const qListPosition_t position );
+    qBool_t qList_SpliceRange( qList_t *const destination, void * const after, qList_t *const source, void * const first, void * const last );
+    qBool_t qList_SplitAt( qList_t *const list, void * const node, qList_t *const newlist );
     qBool_t qList_IsMember( qList_t * const list, void * const node );
     void* qList_GetFront( const qList_t * const list );
     void* qList_GetBack( const qList_t * const list );
     qBool_t qList_IsEmpty( const qList_t * const list );
     size_t qList_Length( const qList_t * const list );
     qBool_t qList_Sort( qList_t * const list, qBool_t (*CompareFcn)(const void *n1, const void *n2) ) ;
+    qBool_t qList_InsertSorted( qList_t * const list, void * const node, qBool_t (*CompareFcn)(const void *n1, const void *n2) );
 
 
     qNode_t* __qNode_Backward( const qNode_t *const node ); /*This function are not intended for the user usage*/
@@ -66,12 +91,134 @@
 
     qBool_t qList_Swap( void *node1, void *node2 );
 
+    /*
+    Inlinable iteration.
+
+    Unlike qList_ForEach, these macros expand to a plain loop, so the
+    compiler can inline the loop body without any function-pointer call.
+    The iteration variable can be any pointer to a node type. The type is
+    given to the macro, so the node is casted explicitly and the macros can
+    also be used from C++ code:
+
+        Job_t *iJob, *NextJob;
+        qList_Iterate( &JobList, Job_t, iJob ){
+            ...
+        }
+        qList_IterateSafe( &JobList, Job_t, iJob, NextJob ){
+            if( iJob->Done ){
+                (void)qList_RemoveItself( iJob );
+            }
+        }
+    */
+    /*void* qList_Begin( qList_t *list )
+
+    Returns the first node of the list or NULL if the list is empty.
+    */
+    #define qList_Begin( list )                         ( (void*)(list)->head )
+    /*void* qList_RBegin( qList_t *list )
+
+    Returns the last node of the list or NULL if the list is empty.
+    */
+    #define qList_RBegin( list )                        ( (void*)(list)->tail )
+    /*void* qList_End( qList_t *list )
+
+    Returns the value that follows the last node in both directions (NULL).
+    */
+    #define qList_End( list )                           ( NULL )
+    /*void* qList_NodeNext( void *node )
+
+    Returns the node after <node>.
+    */
+    #define qList_NodeNext( node )                      ( (void*)( (qNode_t*)(node) )->next )
+    /*void* qList_NodePrev( void *node )
+
+    Returns the node before <node>.
+    */
+    #define qList_NodePrev( node )                      ( (void*)( (qNode_t*)(node) )->prev )
+    /*qList_Iterate( qList_t *list, type, var )
+
+    Loop over the list from the front to the back. <var> is a pointer to 
+    <type> that points to the current node. The current node must not be 
+    removed inside the loop.
+    */
+    #define qList_Iterate( list, type, var )            for( (var) = (type*)qList_Begin( list ) ; qList_End( list ) != (var) ; (var) = (type*)qList_NodeNext( var ) )
+    /*qList_IterateBackward( qList_t *list, type, var )
+
+    Loop over the list from the back to the front. <var> is a pointer to 
+    <type> that points to the current node. The current node must not be 
+    removed inside the loop.
+    */
+    #define qList_IterateBackward( list, type, var )    for( (var) = (type*)qList_RBegin( list ) ; qList_End( list ) != (var) ; (var) = (type*)qList_NodePrev( var ) )
+    /*qList_IterateSafe( qList_t *list, type, var, nextvar )
+
+    Same as qList_Iterate, but the adjacent node is saved in <nextvar>
+    before the loop body runs, so the current node can be removed or
+    moved to another list.
+    */
+    #define qList_IterateSafe( list, type, var, nextvar )           for( (var) = (type*)qList_Begin( list ), (nextvar) = ( NULL != (var) )? (type*)qList_NodeNext( var ) : (type*)NULL ; NULL != (var) ; (var) = (nextvar), (nextvar) = ( NULL != (var) )? (type*)qList_NodeNext( var ) : (type*)NULL )
+    /*qList_IterateBackwardSafe( qList_t *list, type, var, prevvar )
+
+    Same as qList_IterateBackward, but the adjacent node is saved in
+    <prevvar> before the loop body runs, so the current node can be removed
+    or moved to another list.
+    */
+    #define qList_IterateBackwardSafe( list, type, var, prevvar )   for( (var) = (type*)qList_RBegin( list ), (prevvar) = ( NULL != (var) )? (type*)qList_NodePrev( var ) : (type*)NULL ; NULL != (var) ; (var) = (prevvar), (prevvar) = ( NULL != (var) )? (type*)qList_NodePrev( var ) : (type*)NULL )
+
 
     void qList_SetMemoryAllocation( qListMemAllocator_t mallocFcn, qListMemFree_t freeFcn );
     qBool_t qList_DInsert( qList_t *const list, void *data, size_t size, qListPosition_t position );
     void* qList_DRemove( qList_t * const list, void * const node, const qListPosition_t position );
     qBool_t qList_DRemoveItself( void * const node );
 
+    #if ( Q_LIST_POOLS == 1 )
+        qBool_t qListPool_Setup( qListPool_t * const pool, size_t BlockSize, void *Area, size_t AreaSize );
+        void qListPool_SetArena( qListPool_t * const pool, qListMemAllocator_t Allocator, size_t GrowCount );
+        void* qListPool_Alloc( qListPool_t * const pool );
+        qBool_t qListPool_Free( qListPool_t * const pool, void * const block );
+        size_t qListPool_Capacity( const qListPool_t * const pool );
+        size_t qListPool_Used( const qListPool_t * const pool );
+        size_t qListPool_HighWater( const qListPool_t * const pool );
+        qBool_t qList_AttachPool( qList_t * const list, qListPool_t * const pool );
+    #endif
+
+    #if ( Q_LIST_INDEX_LEVELS > 0 )
+        /*
+        Optional skip-list index layered over a sorted qList_t. The index
+        links live in the node itself, so the nodes of an indexed list must 
+        start with the qListIndex_NodeFields member instead of 
+        qNode_MinimalFields:
+
+            typedef struct{
+                qListIndex_NodeFields;
+                qUINT32_t Deadline;
+            }Job_t;
+
+        Note: Once the index is set up, the list must only be modified with 
+              the qListIndex_* functions.
+        */
+        #define qListIndex_NodeFields   qNode_MinimalFields; void *__qIndexForward[ Q_LIST_INDEX_LEVELS ]; size_t __qIndexWidth[ Q_LIST_INDEX_LEVELS ]
+
+        typedef struct qListIndexNode_s{
+            qListIndex_NodeFields;
+        }qListIndexNode_t;
+
+        typedef struct{
+            private_start{
+                qListIndexNode_t Header;        /*< Holds the links of the index before the first node. */
+                qList_t *List;                  /*< The indexed list. */
+                qListCompareFcn_t CompareFcn;   /*< The function that defines the order of the list. */
+                qUINT32_t Seed;                 /*< State of the level generator. */
+                qUINT8_t Height;                /*< The number of index levels currently in use. */
+            }private_end;
+        }qListIndex_t;
+
+        qBool_t qListIndex_Setup( qListIndex_t * const index, qList_t * const list, qBool_t (*CompareFcn)(const void *n1, const void *n2) );
+        qBool_t qListIndex_Insert( qListIndex_t * const index, void * const node );
+        qBool_t qListIndex_Remove( qListIndex_t * const index, void * const node );
+        void* qListIndex_RemoveAt( qListIndex_t * const index, const size_t position );
+        void* qListIndex_GetAt( const qListIndex_t * const index, const size_t position );
+    #endif
+
     #ifdef __cplusplus
     }
     #endif
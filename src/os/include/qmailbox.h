@@ -0,0 +1,66 @@
+/*This file is part of the QuarkTS distribution.*/
+#ifndef QMAILBOX_H
+    #define QMAILBOX_H
+
+    #include "qtypes.h"
+    #include "qcritical.h"
+
+    #include <string.h>
+
+    #ifdef __cplusplus
+    extern "C" {
+    #endif
+
+    /*
+    A mailbox holds the latest values posted by a single writer. It keeps the
+    last <Depth> items and every post overwrites the oldest one, so the 
+    writer never fails and never waits. Each slot is protected by a sequence
+    lock: the readers copy the item and check that the slot was not written 
+    in the meantime (retrying if it was), so the readers never block the 
+    writer and any number of readers can read the same items.
+
+    Every post gets a sequence number (1, 2, 3...). The readers get the 
+    sequence of the item they read, so they can tell how many updates they 
+    missed. The sequence wraps around, and the item with the sequence <s> 
+    lives in the slot ( s - 1 ) modulo <Depth>, so <Depth> must be a power of 
+    two for the slots to stay in step across the wrap-around.
+
+    Each slot takes qMailbox_SlotSize( ItemSize ) bytes. The storage area can 
+    be declared as:
+
+        size_t Area[ qMailbox_AreaWords( sizeof(SensorData_t), 1 ) ];
+    */
+    typedef struct{
+        private_start{
+            qUINT8_t *Storage;          /*< Points to the beginning of the slots. */
+            size_t ItemSize;            /*< The size of each item. */
+            size_t SlotSize;            /*< The size of each slot (sequence lock and item). */
+            size_t Mask;                /*< The number of slots minus one. */
+            volatile size_t Posted;     /*< The number of completed posts (the sequence of the latest item). */
+            volatile qBool_t Empty;     /*< qTrue until the first post, the sequence alone can't tell it after a wrap-around. */
+        }private_end;
+    }qMailbox_t;
+
+    /*size_t qMailbox_SlotSize( size_t ItemSize )
+
+    Returns the size in bytes of a slot able to hold an item of <ItemSize> bytes.
+    */
+    #define qMailbox_SlotSize( ItemSize )               ( ( ( sizeof(size_t) + (ItemSize) + sizeof(size_t) - 1u ) / sizeof(size_t) ) * sizeof(size_t) )
+    /*size_t qMailbox_AreaWords( size_t ItemSize, size_t Depth )
+
+    Returns the number of size_t words needed to hold <Depth> items of
+    <ItemSize> bytes.
+    */
+    #define qMailbox_AreaWords( ItemSize, Depth )       ( ( qMailbox_SlotSize( ItemSize )/sizeof(size_t) )*(Depth) )
+
+    qBool_t qMailbox_Create( qMailbox_t * const obj, size_t *DataArea, size_t ItemSize, size_t Depth );
+    qBool_t qMailbox_Post( qMailbox_t * const obj, const void *Item );
+    size_t qMailbox_Sequence( const qMailbox_t * const obj );
+    qBool_t qMailbox_ReadLatest( const qMailbox_t * const obj, void *dest, size_t * const Sequence );
+    qBool_t qMailbox_ReadNext( const qMailbox_t * const obj, void *dest, size_t * const Cursor );
+
+    #ifdef __cplusplus
+    }
+    #endif
+
+#endif
@@ -0,0 +1,67 @@
+/*This file is part of the QuarkTS distribution.*/
+#ifndef QMPMC_H
+    #define QMPMC_H
+
+    #include "qtypes.h"
+    #include "qcritical.h"
+
+    #include <string.h>
+    #include <stddef.h>
+
+    #ifdef __cplusplus
+    extern "C" {
+    #endif
+
+    /*
+    Bounded multi-producer/multi-consumer ring of fixed-size items. Every slot
+    holds a sequence number next to the item, so producers and consumers only
+    contend on their own index (with a compare-and-swap) and never take a 
+    lock. It is intended to share data between several scheduler instances 
+    running on different threads or cores.
+
+    Each slot takes qMPMC_SlotSize( ItemSize ) bytes. The storage area can be
+    declared as:
+
+        size_t Area[ qMPMC_AreaWords( sizeof(Message_t), 64 ) ];
+
+    Note: Requires Q_ATOMIC_CAS on multi-threaded targets, since the 
+          critical-section fallback does not exclude other threads.
+    */
+    typedef struct{
+        private_start{
+            qUINT8_t *Storage;                                              /*< Points to the beginning of the slots. */
+            size_t ItemSize;                                                /*< The size of each item. */
+            size_t SlotSize;                                                /*< The size of each slot (sequence and item). */
+            size_t Mask;                                                    /*< The number of slots minus one (the number of slots is a power of two). */
+            qUINT8_t PadBefore[ Q_CACHE_LINE_SIZE ];                        /*< Keep the producer index in its own cache line. */
+            volatile size_t EnqueuePos;                                     /*< The next ticket for the producers. */
+            qUINT8_t PadBetween[ Q_CACHE_LINE_SIZE - sizeof(size_t) ];      /*< Keep the consumer index in its own cache line. */
+            volatile size_t DequeuePos;                                     /*< The next ticket for the consumers. */
+            qUINT8_t PadAfter[ Q_CACHE_LINE_SIZE - sizeof(size_t) ];
+        }private_end;
+    }qMPMC_t;
+
+    /*size_t qMPMC_SlotSize( size_t ItemSize )
+
+    Returns the size in bytes of a slot able to hold an item of <ItemSize> bytes.
+    */
+    #define qMPMC_SlotSize( ItemSize )                  ( ( ( sizeof(size_t) + (ItemSize) + sizeof(size_t) - 1u ) / sizeof(size_t) ) * sizeof(size_t) )
+    /*size_t qMPMC_AreaWords( size_t ItemSize, size_t ItemsCount )
+
+    Returns the number of size_t words needed to hold <ItemsCount> items of
+    <ItemSize> bytes.
+    */
+    #define qMPMC_AreaWords( ItemSize, ItemsCount )     ( ( qMPMC_SlotSize( ItemSize )/sizeof(size_t) )*(ItemsCount) )
+
+    qBool_t qMPMC_Create( qMPMC_t * const obj, size_t *DataArea, size_t ItemSize, size_t ItemsCount );
+    qBool_t qMPMC_TrySend( qMPMC_t * const obj, const void *ItemToSend );
+    qBool_t qMPMC_TryReceive( qMPMC_t * const obj, void *dest );
+    size_t qMPMC_SendN( qMPMC_t * const obj, const void *Items, size_t n );
+    size_t qMPMC_ReceiveN( qMPMC_t * const obj, void *dest, size_t n );
+    size_t qMPMC_Count( const qMPMC_t * const obj );
+
+    #ifdef __cplusplus
+    }
+    #endif
+
+#endif
@@ -0,0 +1,41 @@
+/*This file is part of the QuarkTS distribution.*/
+#ifndef QMPSC_H
+    #define QMPSC_H
+
+    #include "qtypes.h"
+    #include "qcritical.h"
+    #include "qlists.h"
+
+    #ifdef __cplusplus
+    extern "C" {
+    #endif
+
+    /*
+    Intrusive multi-producer/single-consumer handoff (Treiber stack). Any 
+    number of producers (ISRs, threads or tasks) push nodes with a single 
+    compare-and-swap, without disabling the interrupts. The consumer takes 
+    all the pushed nodes at once and gets them back in the push order.
+
+    The nodes are the same as the ones used by qList_t (qNode_MinimalFields),
+    so a batch can be moved to a list without any copy. While a node is
+    pending in the handoff, its container points to the MPSC object, so a
+    second push of the same node is rejected. It can be pushed again once
+    it has been taken by the consumer.
+    */
+    typedef struct{
+        private_start{
+            void * volatile Head;   /*< The last pushed node. Each node points to the previously pushed one. */
+        }private_end;
+    }qMPSC_t;
+
+    qBool_t qMPSC_Initialize( qMPSC_t * const obj );
+    qBool_t qMPSC_Push( qMPSC_t * const obj, void * const node );
+    qBool_t qMPSC_IsEmpty( const qMPSC_t * const obj );
+    void* qMPSC_PopAll( qMPSC_t * const obj );
+    size_t qMPSC_PopAllToList( qMPSC_t * const obj, qList_t * const list );
+
+    #ifdef __cplusplus
+    }
+    #endif
+
+#endif
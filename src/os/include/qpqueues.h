@@ -0,0 +1,63 @@
+/*This file is part of the QuarkTS distribution.*/
+#ifndef QPQUEUES_H
+    #define QPQUEUES_H
+
+    #include "qtypes.h"
+    #include "qcritical.h"
+
+    #include <string.h>
+
+    #ifdef __cplusplus
+    extern "C" {
+    #endif
+
+    /*
+    A priority message queue. Like a qQueue_t, the items are fixed-size and
+    queued by copy, but they are received in priority order (the highest 
+    priority first) and in FIFO order among the items with the same priority.
+    The order is kept by a binary heap of small entries, so the items are 
+    never moved once copied in. Send and receive are O(log n).
+
+    The application supplies the item storage and an array of entries, both 
+    with room for the same number of items:
+
+        Command_t CmdArea[ 16 ];
+        qPQueueEntry_t CmdEntries[ 16 ];
+    */
+    typedef struct{
+        qUINT32_t Stamp;        /*< The send order of the item, to keep the FIFO order among equal priorities. */
+        size_t Slot;            /*< The index of the item in the storage area. */
+        qPriority_t Priority;   /*< The priority of the item. */
+    }qPQueueEntry_t;
+
+    typedef struct{
+        private_start{
+            qUINT8_t *Storage;          /*< Points to the beginning of the item storage area. */
+            qPQueueEntry_t *Entries;    /*< The heap, followed by the held slots and the free slots at the end of the array. */
+            size_t ItemSize;            /*< The size of each item. */
+            size_t ItemsCount;          /*< The max number of items the queue can hold. */
+            volatile size_t Count;      /*< The number of items in the heap. */
+            size_t Free;                /*< The number of free slots. */
+            qUINT32_t Stamp;            /*< The stamp for the next item. */
+        }private_end;
+    }qPQueue_t;
+
+    qBool_t qPQueueCreate( qPQueue_t * const obj, void *DataArea, qPQueueEntry_t *Entries, size_t ItemSize, size_t ItemsCount );
+    void qPQueueReset( qPQueue_t * const obj );
+    qBool_t qPQueueSend( qPQueue_t * const obj, const void *ItemToQueue, const qPriority_t Priority );
+    qBool_t qPQueueReceive( qPQueue_t * const obj, void *dest, qPriority_t * const Priority );
+    void* qPQueuePeek( const qPQueue_t * const obj );
+    qBool_t qPQueueRemoveFront( qPQueue_t * const obj );
+    size_t qPQueueCount( const qPQueue_t * const obj );
+    qBool_t qPQueueIsEmpty( const qPQueue_t * const obj );
+    qBool_t qPQueueIsFull( const qPQueue_t * const obj );
+
+    /*Zero-copy access*/
+    void* qPQueueReceiveSlot( qPQueue_t * const obj );
+    qBool_t qPQueueRelease( qPQueue_t * const obj, void * const slot );
+
+    #ifdef __cplusplus
+    }
+    #endif
+
+#endif
@@ -4,6 +4,10 @@
 
     #include "qtypes.h"
     #include "qcritical.h"
+    #include "qhooks.h"
+    #if ( Q_QUEUE_STATS == 1 )
+        #include "qclock.h"
+    #endif
     
     #include <string.h>
 
@@ -11,6 +15,22 @@
     extern "C" {
     #endif
     
+    #if ( Q_QUEUE_SET_SIZE > 0 )
+        struct qQueueSet_s;
+    #endif
+
+    #if ( Q_QUEUE_STATS == 1 )
+        typedef struct{
+            size_t HighWater;           /*< The max number of items ever held by the queue. */
+            size_t SendFailures;        /*< The number of items rejected because the queue was full. */
+            size_t Dropped;             /*< The number of items discarded by overwrite sends. */
+            qUINT32_t TotalItems;       /*< The number of items sent to the queue. */
+            qClock_t LatencyMax;        /*< The max time (in epochs) an item spent in the queue. */
+            qClock_t LatencySum;        /*< The sum of the measured latencies (LatencySum/LatencySamples gives the average). */
+            qUINT32_t LatencySamples;   /*< The number of measured latencies. */
+        }qQueueStats_t;
+    #endif
+
     typedef struct {
         qUINT8_t *pHead;			    /*< Points to the beginning of the queue storage area. */
         qUINT8_t *pTail;			    /*< Points to the byte at the end of the queue storage area.  Once more byte is allocated than necessary to store the queue items, this is used as a marker. */
@@ -19,10 +39,48 @@
         volatile size_t ItemsWaiting;   /*< The number of items currently in the queue. */
         size_t ItemsCount;		        /*< The length of the queue defined as the number of items it will hold, not the number of bytes. */
         size_t ItemSize;		        /*< The size of each items that the queue will hold. */
+        volatile size_t ItemsSent;      /*< Lock-free mode: the number of items sent. Only modified by the producer. */
+        volatile size_t ItemsReceived;  /*< Lock-free mode: the number of items received. Only modified by the consumer. */
+        qBool_t LockFree;               /*< The queue was created with qQueueCreateSPSC. */
+        void *HeldSlot;                 /*< The front slot taken by qQueuePeekSlot until qQueueRelease (NULL if none). */
+        #if ( Q_QUEUE_STATS == 1 )
+            qQueueStats_t Stats;        /*< The statistics of the queue. */
+            qClock_t *Timestamps;       /*< Optional. The send time of the item in each slot, to measure the latency. */
+            const char *Name;           /*< The name used to identify the queue in the statistics registry. */
+            void *NextRegistered;       /*< The next queue in the statistics registry. */
+        #endif
+        #if ( Q_QUEUE_SET_SIZE > 0 )
+            struct qQueueSet_s *Set;    /*< The queue set that holds the queue (NULL if none). */
+            qUINT32_t SetBit;           /*< The bit of the queue in the ready mask of the set. */
+        #endif
     }qQueue_t;
 
+    #if ( Q_QUEUE_SET_SIZE > 0 )
+        /*
+        A queue set groups up to Q_QUEUE_SET_SIZE queues, so a single task can
+        wait on all of them (see qTaskAttachQueueSet). Each member owns a bit 
+        in the ready mask of the set, which is updated by the queue operations
+        every time the member becomes non-empty or empty, so selecting a ready
+        member does not require a scan of the queues.
+        A queue can belong to one set at a time, and the lock-free queues
+        (qQueueCreateSPSC) can't be added. The created sets are kept in a 
+        registry, so a queue that is created again is first removed from the
+        set that holds it.
+        */
+        typedef struct qQueueSet_s{
+            private_start{
+                qQueue_t *Members[ Q_QUEUE_SET_SIZE ];  /*< The queues in the set, indexed by their bit. */
+                volatile qUINT32_t ReadyMask;           /*< One bit for each member that holds items. */
+                qUINT32_t UsedMask;                     /*< One bit for each used entry of <Members>. */
+                qUINT8_t Last;                          /*< The index of the last selected member (round-robin). */
+                struct qQueueSet_s *Next;               /*< The next set in the registry of created sets. */
+            }private_end;
+        }qQueueSet_t;
+    #endif
+
     #define QUEUE_SEND_TO_BACK     ( 0u )
     #define QUEUE_SEND_TO_FRONT    ( 1u )
+    #define QUEUE_OVERWRITE        ( 2u )
     typedef qUINT8_t qQueueMode_t;
 
     /*qBool_t qQueueSendToBack(qQueue_t *obj, void *ItemToQueue)
@@ -76,9 +134,32 @@
         qTrue on successful add, qFalse if not added
     */        
     #define qQueueSendToFront(_qQueue_t_, _ItemToQueue_)    qQueueGenericSend((_qQueue_t_), (_ItemToQueue_), QUEUE_SEND_TO_FRONT)
+    /*qBool_t qQueueOverwrite(qQueue_t *obj, void *ItemToQueue)
+    
+    Post an item to the back of the queue. If the queue is full, the oldest
+    item is discarded to make room for the new one. Intended for "latest 
+    value" data, where only the newest items matter. 
+    While a receiver task processes the oldest item in place, that item can't
+    be discarded, so the newest one is replaced instead. A queue of length 1
+    has nothing else to replace, and the send fails until the receiver task
+    ends its callback: use a length of 2 or more when the queue is attached 
+    to a receiver task, or a qMailbox_t.
+    Not available for the lock-free queues (qQueueCreateSPSC).
+    
+    Parameters:
+
+        - obj : a pointer to the Queue object
+        - ItemToQueue : A pointer to the item that is to be placed on the queue.
+    
+    Return value:
+
+        qTrue on successful add, qFalse if not added
+    */        
+    #define qQueueOverwrite(_qQueue_t_, _ItemToQueue_)      qQueueGenericSend((_qQueue_t_), (_ItemToQueue_), QUEUE_OVERWRITE)
 
 
     qBool_t qQueueCreate( qQueue_t * const obj, void* DataArea, size_t ItemSize, size_t ItemsCount );
+    qBool_t qQueueCreateSPSC( qQueue_t * const obj, void* DataArea, size_t ItemSize, size_t ItemsCount );
     void qQueueReset( qQueue_t * const obj );
     qBool_t qQueueIsEmpty( const qQueue_t * const obj );
     size_t qQueueCount( const qQueue_t * const obj );
@@ -88,6 +169,35 @@
     qBool_t qQueueRemoveFront( qQueue_t * const obj );
     qBool_t qQueueReceive (qQueue_t * const obj, void *dest );
     qBool_t qQueueGenericSend( qQueue_t * const obj, void *ItemToQueue, qQueueMode_t InsertMode );
+    size_t qQueueSendN( qQueue_t * const obj, const void *Items, size_t n );
+    size_t qQueueReceiveN( qQueue_t * const obj, void *dest, size_t n );
+
+    /*Zero-copy access*/
+    void* qQueueReserve( qQueue_t * const obj );
+    qBool_t qQueueCommit( qQueue_t * const obj, void * const slot );
+    void* qQueuePeekSlot( qQueue_t * const obj );
+    qBool_t qQueueRelease( qQueue_t * const obj, void * const slot );
+
+    #if ( Q_QUEUE_STATS == 1 )
+        /*
+        Called by qQueueForEachStats for every registered queue. 
+        */
+        typedef void (*qQueueStatsFcn_t)( const qQueue_t * const Queue, const char *Name, const qQueueStats_t * const Stats, void *arg );
+
+        qBool_t qQueueRegisterStats( qQueue_t * const obj, const char *Name, qClock_t *Timestamps );
+        qBool_t qQueueUnregisterStats( const qQueue_t * const obj );
+        qBool_t qQueueGetStats( const qQueue_t * const obj, qQueueStats_t * const dest );
+        void qQueueResetStats( qQueue_t * const obj );
+        void qQueueForEachStats( const qQueueStatsFcn_t Fcn, void *arg );
+    #endif
+
+    #if ( Q_QUEUE_SET_SIZE > 0 )
+        qBool_t qQueueSetCreate( qQueueSet_t * const set );
+        qBool_t qQueueSetAdd( qQueueSet_t * const set, qQueue_t * const queue );
+        qBool_t qQueueSetRemove( qQueueSet_t * const set, qQueue_t * const queue );
+        qBool_t qQueueSetIsReady( const qQueueSet_t * const set );
+        qQueue_t* qQueueSetSelect( qQueueSet_t * const set );
+    #endif
     
     #ifdef __cplusplus
     }
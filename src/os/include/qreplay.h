@@ -0,0 +1,59 @@
+/*This file is part of the QuarkTS distribution.*/
+#ifndef QREPLAY_H
+    #define QREPLAY_H
+
+    #include "qtypes.h"
+    #include "qclock.h"
+    #include "qkernel.h"
+
+    #ifdef __cplusplus
+    extern "C" {
+    #endif
+
+    /*
+    Deterministic record/replay of the kernel inputs.
+
+    While recording, every value returned by qClock_GetTick and every input
+    injected through the qReplay_*FromISR wrappers is written to a compact
+    binary stream using the user-supplied output function. Tick reads are
+    stored as deltas and consecutive reads of the same value are collapsed
+    into a single repeat record.
+
+    While replaying, qClock_GetTick returns the recorded values and the
+    recorded inputs are injected again right before the tick read that
+    followed them, so the scheduler sees the same trigger sequence without
+    waiting for the real time to elapse.
+
+    Tasks, queues and event-data pointers are stored by their registration
+    index (see qReplay_Register), so the objects must be registered in the
+    same order in both the recording and the replaying application.
+    */
+
+    typedef void (*qReplayWriteFcn_t)( const void *src, size_t n, void *arg );
+    typedef size_t (*qReplayReadFcn_t)( void *dst, size_t n, void *arg );
+
+    typedef enum{
+        qReplay_Idle,
+        qReplay_Recording,
+        qReplay_Replaying,
+        qReplay_Finished
+    }qReplayState_t;
+
+    qBool_t qReplay_Register( void * const Object );
+    qBool_t qReplay_StartRecording( const qReplayWriteFcn_t Output, void *arg );
+    qBool_t qReplay_StartReplay( const qReplayReadFcn_t Input, void *arg );
+    void qReplay_Stop( void );
+    qReplayState_t qReplay_GetState( void );
+
+    qBool_t qReplay_SendNotificationFromISR( qTask_t * const Task, void *eventdata );
+    qBool_t qReplay_QueueNotificationFromISR( qTask_t * const Task, void *eventdata );
+    void qReplay_ModifyEventFlagsFromISR( qTask_t * const Task, qTaskFlag_t flags, qBool_t action );
+    #if ( Q_QUEUES == 1 )
+        qBool_t qReplay_QueueSendFromISR( qQueue_t * const Queue, void *ItemToQueue, qQueueMode_t InsertMode );
+    #endif
+
+    #ifdef __cplusplus
+    }
+    #endif
+
+#endif
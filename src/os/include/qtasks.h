@@ -8,12 +8,21 @@
     
     #if (Q_QUEUES == 1)
         #include "qqueues.h"
+        #include "qpqueues.h"
+    #endif
+
+    #if ( Q_CHANNELS == 1 )
+        #include "qchannels.h"
     #endif
 
     #if ( Q_FSM == 1)
         #include "qfsm.h"
     #endif  
 
+    #if ( Q_TASK_REGISTRY == 1 )
+        #include "qhashmaps.h"
+    #endif
+
     #if ( Q_ATCOMMAND_PARSER == 1)
         #include "qatparser.h"
     #endif
@@ -31,6 +40,8 @@
                     byQueueCount, 
                     byQueueEmpty, 
                     byEventFlags,
+                    byChannelReceiver,
+                    byQueueSet,
                     bySchedulingRelease, 
                     byNoReadyTasks
                 }qTrigger_t;
@@ -43,6 +54,8 @@
     #define qTrigger_QueueCount             ( byQueueCount )
     #define qTrigger_QueueEmpty             ( byQueueEmpty )
     #define qTrigger_byEventFlags           ( byEventFlags )
+    #define qTrigger_ChannelReceiver        ( byChannelReceiver )
+    #define qTrigger_QueueSet               ( byQueueSet )
     #define qTrigger_SchedulingRelease      ( bySchedulingRelease )
     #define qTrigger_NoReadyTasks           ( byNoReadyTasks )
 
@@ -62,7 +75,7 @@
     /* Task flags
     MSB_________________________________________________________________________________________________________________________________________________________LSB
     31                  |                 |            |            |               |               |              |                  |             |           0
-    |(31..11)EVENTFLAGS |  (10..8)-STATE  | 7-REM.REQ  | 6-SHUTDOWN | 5-QUEUE_EMPTY | 4-QUEUE_COUNT | 3-QUEUE_FULL | 2-QUEUE_RECEIVER |  1-ENABLED  |  0-INIT   |
+    |(31..11)EVENTFLAGS |  (10..8)-STATE  | 7-RELEASE  | 6-SHUTDOWN | 5-QUEUE_EMPTY | 4-QUEUE_COUNT | 3-QUEUE_FULL | 2-QUEUE_RECEIVER |  1-ENABLED  |  0-INIT   |
     |___________________|_________________|____________|____________|_______________|_______________|______________|__________________|_____________|___________|
     */
     #define QTASK_COREBITS_RSMASK       ( 0x000000FFuL )	 
@@ -85,7 +98,7 @@
     #define __QTASK_BIT_QUEUE_COUNT     ( 0x00000010uL )
     #define __QTASK_BIT_QUEUE_EMPTY     ( 0x00000020uL )
     #define __QTASK_BIT_SHUTDOWN        ( 0x00000040uL )
-    #define __QTASK_BIT_REMOVE_REQUEST  ( 0x00000080uL )
+    #define __QTASK_BIT_RELEASE         ( 0x00000080uL )
 
     /*The task Bit-Flag definitions*/
     #define QEVENTFLAG_01               ( 0x00001000uL )
@@ -142,10 +155,15 @@
                         by qSendEvent. A pointer to the dequeued data will be 
                         available in the <EventData> field.
         
+        The queue triggers also apply to an attached qPQueue (priority queue),
+        in that case, the item with the highest priority is the front one.
+
         - byQueueReceiver: When there are elements available in the attached qQueue,
                         the scheduler make a data dequeue (auto-receive) from the
-                        front. A pointer to the received data will be 
-                        available in the <EventData> field.
+                        front. A pointer to the front slot of the queue will be 
+                        available in the <EventData> field, so the item can be
+                        processed in place. The slot is released after the
+                        task callback returns.
         
         - byQueueFull: When the  attached qQueue is full. A pointer to the 
                          queue will be available in the <EventData> field.
@@ -156,6 +174,18 @@
         
         - byQueueEmpty: When the  attached qQueue is empty.  A pointer to the 
                         queue will be available in the <EventData> field.
+
+        - byChannelReceiver: When there are items available in the attached
+                        qChannel. A pointer to the item at the front of the
+                        channel will be available in the <EventData> field.
+                        The item is processed in place and the dispatcher
+                        removes it after the callback returns.
+
+        - byQueueSet: When any of the queues in the attached queue set has 
+                        items. A pointer to the selected member queue will 
+                        be available in the <EventData> field. The items are
+                        not removed, the task should receive them from that
+                        queue.
         
         - byNoReadyTasks: Only when the Idle Task is triggered.
         */
@@ -194,15 +224,32 @@
             #endif
             #if ( Q_QUEUES == 1)
                 qQueue_t *Queue;                    /*< The pointer to the attached queue. */
+                qPQueue_t *PQueue;                  /*< The pointer to the attached priority queue. */
                 qUINT32_t QueueCount;
+                #if ( Q_QUEUE_SET_SIZE > 0 )
+                    qQueueSet_t *QueueSet;          /*< The pointer to the attached queue set. */
+                #endif
+            #endif
+            #if ( Q_CHANNELS == 1 )
+                qChannel_t *Channel;                /*< The pointer to the attached channel. */
             #endif
             qSTimer_t timer;                        /*< To handle the task timming*/
             #if ( Q_TASK_COUNT_CYCLES == 1 )
                 qCycles_t Cycles;                   /*< The current number of executions performed by the task. */
             #endif
+            #if ( Q_SCHEDULER_LOAD == 1 )
+                qClock_t BusyTime;                  /*< The time spent by the callback in the current measurement window. */
+                qUINT16_t Load;                     /*< The load of the task in the last measurement window (per-mille). */
+            #endif
             #if ( Q_PRESERVE_TASK_ENTRY_ORDER == 1)
                 size_t Entry;
             #endif
+            #if ( Q_TASK_REGISTRY == 1 )
+                qHashNode_t IDNode;                 /*< Links the task in the ID map of the registry. */
+                qHashNode_t NameNode;               /*< Links the task in the name map of the registry. */
+                const char *Name;                   /*< The task name (optional). */
+                qUINT32_t ID;                       /*< The task identifier, assigned by qSchedulerAdd_Task. */
+            #endif
             qIteration_t Iterations;                /*< Holds the number of iterations. */
             volatile qNotifier_t Notification;      /*< The notification value. */          
             volatile qTaskFlag_t Flags;             /*< Task flags (core and eventflags)*/
@@ -234,12 +281,20 @@
     #if ( Q_TASK_COUNT_CYCLES == 1 )
         qCycles_t qTaskGetCycles( const qTask_t * const Task );   
     #endif
+    #if ( Q_SCHEDULER_LOAD == 1 )
+        qUINT16_t qTaskGetLoad( const qTask_t * const Task );
+    #endif
     void qTaskSetTime( qTask_t * const Task, const qTime_t Value );
     void qTaskSetIterations( qTask_t * const Task, const qIteration_t Value );
     void qTaskSetPriority( qTask_t * const Task, const qPriority_t Value );
     void qTaskSetCallback( qTask_t * const Task, const qTaskFcn_t CallbackFcn );
     void qTaskSetState( qTask_t * const Task, const qState_t State );
     void qTaskSetData( qTask_t * const Task, void* arg );
+    #if ( Q_TASK_REGISTRY == 1 )
+        qBool_t qTaskSetName( qTask_t * const Task, const char *Name );
+        const char* qTaskGetName( const qTask_t * const Task );
+        qUINT32_t qTaskGetID( const qTask_t * const Task );
+    #endif
     void qTaskClearTimeElapsed( qTask_t * const Task );
 
     /*void qTaskSuspend(qTask_t *Task)
@@ -311,8 +366,16 @@
 
     #if ( Q_QUEUES == 1 )
         qBool_t qTaskAttachQueue( qTask_t * const Task, qQueue_t * const Queue, const qQueueLinkMode_t Mode, const qUINT16_t arg );
+        qBool_t qTaskAttachPQueue( qTask_t * const Task, qPQueue_t * const PQueue, const qQueueLinkMode_t Mode, const qUINT16_t arg );
+        #if ( Q_QUEUE_SET_SIZE > 0 )
+            qBool_t qTaskAttachQueueSet( qTask_t * const Task, qQueueSet_t * const Set );
+        #endif
     #endif 
 
+    #if ( Q_CHANNELS == 1 )
+        qBool_t qTaskAttachChannel( qTask_t * const Task, qChannel_t * const Channel );
+    #endif
+
     #if ( Q_FSM == 1 ) 
         qBool_t qTaskAttachStateMachine( qTask_t * const Task, qSM_t * const StateMachine );
     #endif
@@ -0,0 +1,84 @@
+/*This file is part of the QuarkTS distribution.*/
+#ifndef QTREES_H
+    #define QTREES_H
+
+    #include "qtypes.h"
+    #include "qlists.h"
+    #include <stddef.h>
+
+    #ifdef __cplusplus
+    extern "C" {
+    #endif
+
+    /*
+    Intrusive red-black tree. The nodes are user structures that embed the
+    qTreeNode_MinimalFields header, so the tree never allocates memory:
+
+        typedef struct{
+            qTreeNode_MinimalFields;
+            qClock_t Deadline;
+        }Timeout_t;
+
+    The order is defined by a three-way comparison function, and nodes
+    that compare equal are allowed (they are kept in insertion order).
+    Insertion, removal, min, max, lower bound and lookup are O(log n);
+    successor and predecessor are O(1) amortized.
+
+    If the header can't be the first member of the structure, embed a
+    qTreeNode_t member instead, pass its address to the qTree_* functions
+    and get back the structure with qTree_Entry.
+    */
+    #define qTreeNode_MinimalFields     struct qTreeNode_s *__qTreeLeft, *__qTreeRight, *__qTreeParent; void *__qTreeContainer; qUINT8_t __qTreeColor
+
+    typedef struct qTreeNode_s{
+        qTreeNode_MinimalFields;
+    }qTreeNode_t;
+
+    /*
+    Should return a negative value if <n1> goes before <n2>, a positive value
+    if <n1> goes after <n2> or 0(zero) if both are equivalent. The lookup
+    functions pass the key node as <n2>.
+    */
+    typedef int (*qTreeCompareFcn_t)( const void *n1, const void *n2 );
+
+    typedef struct{
+        private_start{
+            qTreeNode_t *Root;              /*< The root node of the tree. */
+            qTreeCompareFcn_t CompareFcn;   /*< The function that defines the order of the nodes. */
+            size_t Count;                   /*< The number of nodes in the tree. */
+        }private_end;
+    }qTree_t;
+
+    /*type* qTree_Entry( void *node, type, member )
+
+    Returns a pointer to the structure of type <type> that embeds the
+    qTreeNode_t <member> pointed by <node>.
+    */
+    #define qTree_Entry( node, type, member )       ( (type*)( (void*)( (qUINT8_t*)(node) - offsetof( type, member ) ) ) )
+    /*qTree_Iterate( qTree_t *tree, type, var )
+
+    Loop over the tree in order (from the min to the max). <var> is a pointer
+    to <type> that points to the current node. The current node must not be
+    removed inside the loop.
+    */
+    #define qTree_Iterate( tree, type, var )        for( (var) = (type*)qTree_Min( tree ) ; NULL != (var) ; (var) = (type*)qTree_Next( var ) )
+
+    qBool_t qTree_Initialize( qTree_t * const tree, const qTreeCompareFcn_t CompareFcn );
+    qBool_t qTree_Insert( qTree_t * const tree, void * const node );
+    qBool_t qTree_Remove( qTree_t * const tree, void * const node );
+    void* qTree_Find( const qTree_t * const tree, const void *key );
+    void* qTree_LowerBound( const qTree_t * const tree, const void *key );
+    void* qTree_UpperBound( const qTree_t * const tree, const void *key );
+    void* qTree_Min( const qTree_t * const tree );
+    void* qTree_Max( const qTree_t * const tree );
+    void* qTree_Next( const void * const node );
+    void* qTree_Prev( const void * const node );
+    size_t qTree_Count( const qTree_t * const tree );
+    qBool_t qTree_IsEmpty( const qTree_t * const tree );
+    qBool_t qTree_ForEach( qTree_t * const tree, const qListNodeFcn_t Fcn, void *arg );
+
+    #ifdef __cplusplus
+    }
+    #endif
+
+#endif
@@ -48,9 +48,7 @@
 
     #ifndef STRUCT_PRIVATE_MEMBERS /*to define private inside kernel objects*/
         #define STRUCT_PRIVATE_MEMBERS
-        #define ___private_join( symbol1, symbol2 )     ___private_do_join( symbol1, symbol2 )
-        #define ___private_do_join( symbol1, symbol2 )   symbol1##symbol2
-        #define private_start                           struct ___private_join( qPrivate_, __LINE__ )
+        #define private_start                           struct /*untagged, so the private members of two objects can't collide*/
         #define private_end                             qPrivate
     #endif
 
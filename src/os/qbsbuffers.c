@@ -2,20 +2,19 @@
 
 #if ( Q_BYTE_SIZED_BUFFERS ==1 )
 
-static size_t _qQueueValidPowerOfTwo( size_t k );
+static size_t _qBSBuffer_PowerOfTwoBelow( size_t k );
 
 /*============================================================================*/
-static size_t _qQueueValidPowerOfTwo( size_t k ){
-    qIndex_t i;
-    size_t r = k;
-    if( ((k-1u) & k) != 0u ){
-        k--;
-        for( i = 1u; i<sizeof(qIndex_t)*8u; i= (qIndex_t) (i * 2u)){
-            k = k | (size_t)( k >> i );
+/*the largest power of two that fits in <k>, so the buffer is never exceeded*/
+static size_t _qBSBuffer_PowerOfTwoBelow( size_t k ){
+    size_t r = 0u;
+    if( k > 0u ){
+        r = 1u;
+        while( r <= ( k >> 1u ) ){
+            r <<= 1u;
         }
-        k = (size_t) ((k + 1u) >> 1u);
     }
-    return ( k < r )? k*2u : k;
+    return r;
 }
 /*============================================================================*/
 /*size_t qBSBuffer_Count(const qBSBuffer_t * const obj)
@@ -98,7 +97,7 @@ qUINT8_t qBSBuffer_Peek( const qBSBuffer_t * const obj ){
     qUINT8_t RetValue = 0x0u;
     qIndex_t index;
     if( NULL != obj ){
-        index = obj->tail % obj->length;
+        index = obj->tail & ( obj->length - 1u ); /*the length is a power of two*/
         RetValue = (qUINT8_t) ( obj->buffer[ index ] ); /*MISRAC2004-17.4_b deviation allowed*/
     }
     return RetValue;
@@ -119,19 +118,62 @@ Return value:
 */
 qBool_t qBSBuffer_Get( qBSBuffer_t * const obj, qUINT8_t *dest ){
     qBool_t RetValue = qFalse;
-    qIndex_t index;
-    if ( qFalse == qBSBuffer_Empty( obj ) ) {
-        index = obj->tail % obj->length;
-        *dest = obj->buffer[ index ]; /*MISRAC2004-17.4_b deviation allowed*/
-        obj->tail++;
-        RetValue = qTrue;
+    qIndex_t tail;
+    if( NULL != obj ){
+        tail = obj->tail; /*to avoid side effects*/
+        if( obj->head != tail ){
+            qCritical_MemoryBarrier(); /*read the head before the data*/
+            *dest = obj->buffer[ tail & ( obj->length - 1u ) ]; /*MISRAC2004-17.4_b deviation allowed*/
+            qCritical_MemoryBarrier(); /*finish the read before releasing the space*/
+            obj->tail = tail + 1u;
+            RetValue = qTrue;
+        }
     }
     return RetValue;
 }
 /*============================================================================*/
+/*size_t qBSBuffer_ReadUpTo( qBSBuffer_t * const obj, void *dest, const size_t n )
+ 
+Gets up to n data-bytes from the BSBuffer(Byte-sized Buffer) and removes them. 
+The bytes are copied in at most two contiguous blocks (before and after the 
+wrap).
+ 
+Parameters:
+
+    - obj : A pointer to the qBSBuffer(Byte-sized Buffer) object
+    - dest: The location where the data will be written
+    - n : The max number of bytes to read
+  
+Return value:
+
+    The number of bytes actually read.
+*/
+size_t qBSBuffer_ReadUpTo( qBSBuffer_t * const obj, void *dest, const size_t n ){
+    size_t available = 0u, first, index;
+    qUINT8_t *data = (qUINT8_t*)dest;
+    qIndex_t tail;
+    if( ( NULL != obj ) && ( NULL != dest ) && ( n > 0u ) ){
+        tail = obj->tail; /*to avoid side effects*/
+        available = (size_t)( obj->head - tail );
+        available = ( n < available )? n : available;
+        if( available > 0u ){
+            qCritical_MemoryBarrier(); /*read the head before the data*/
+            index = tail & ( obj->length - 1u ); /*the length is a power of two*/
+            first = obj->length - index; /*bytes before the wrap*/
+            first = ( available < first )? available : first;
+            (void)memcpy( data, (const void*)&obj->buffer[ index ], first ); /*MISRAC2012-Rule-11.8 allowed*/
+            (void)memcpy( &data[ first ], (const void*)obj->buffer, available - first ); /*MISRAC2012-Rule-11.8 allowed*/
+            qCritical_MemoryBarrier(); /*finish the copy before releasing the space*/
+            obj->tail = tail + available;
+        }
+    }
+    return available;
+}
+/*============================================================================*/
 /*qBool_t qBSBuffer_Read( qBSBuffer_t * const obj, void *dest, const qSize_t n )
  
-Gets n data from the BSBuffer(Byte-sized Buffer) and removes them
+Gets n data from the BSBuffer(Byte-sized Buffer) and removes them. If there are
+less than n bytes available, all of them are read.
  
 Parameters:
 
@@ -143,14 +185,9 @@ Return value:
     qTrue on success, otherwise returns qFalse
 */
 qBool_t qBSBuffer_Read( qBSBuffer_t * const obj, void *dest, const size_t n ){
-    size_t i;
-    qUINT8_t *data = (qUINT8_t*)dest;
     qBool_t RetValue = qFalse;
     if( n > 0u ){
-        RetValue = qTrue;
-        for( i = 0u ; i < n ; i++ ){
-            RetValue = qBSBuffer_Get( obj, &data[i] ); /*MISRAC2004-17.4_a deviation allowed*/
-        }
+        RetValue = ( n == qBSBuffer_ReadUpTo( obj, dest, n ) )? qTrue : qFalse;
     }
     return RetValue;
 }
@@ -170,16 +207,212 @@ Return value:
 */
 qBool_t qBSBuffer_Put( qBSBuffer_t * const obj, const qUINT8_t data ){
     qBool_t status = qFalse;
+    qIndex_t head;
     if( NULL != obj ){ 
-        if( qFalse == qBSBuffer_IsFull( obj ) ) {/* limit the ring to prevent overwriting */
-            obj->buffer[obj->head % obj->length] = data; /*MISRAC2004-17.4_b deviation allowed*/
-            obj->head++;
+        head = obj->head; /*to avoid side effects*/
+        if( (size_t)( head - obj->tail ) < obj->length ) {/* limit the ring to prevent overwriting */
+            qCritical_MemoryBarrier(); /*read the tail before overwriting the free space*/
+            obj->buffer[ head & ( obj->length - 1u ) ] = data; /*MISRAC2004-17.4_b deviation allowed*/
+            qCritical_MemoryBarrier(); /*publish the data before the head*/
+            obj->head = head + 1u;
             status = qTrue;
         }
     }
     return status;
 }
 /*============================================================================*/
+/*size_t qBSBuffer_WriteUpTo( qBSBuffer_t * const obj, const void *src, const size_t n )
+ 
+Adds up to n data-bytes to the BSBuffer(Byte-sized Buffer), as many as fit.
+The bytes are copied in at most two contiguous blocks (before and after the 
+wrap).
+
+Parameters:
+
+    - obj : A pointer to the qBSBuffer(Byte-sized Buffer) object
+    - src : The data to be added
+    - n : The number of bytes to add
+  
+Return value:
+
+    The number of bytes actually added.
+*/
+size_t qBSBuffer_WriteUpTo( qBSBuffer_t * const obj, const void *src, const size_t n ){
+    size_t room = 0u, first, index;
+    const qUINT8_t *data = (const qUINT8_t*)src;
+    qIndex_t head;
+    if( ( NULL != obj ) && ( NULL != src ) && ( n > 0u ) ){
+        head = obj->head; /*to avoid side effects*/
+        room = obj->length - (size_t)( head - obj->tail );
+        room = ( n < room )? n : room;
+        if( room > 0u ){
+            qCritical_MemoryBarrier(); /*read the tail before overwriting the free space*/
+            index = head & ( obj->length - 1u ); /*the length is a power of two*/
+            first = obj->length - index; /*free bytes before the wrap*/
+            first = ( room < first )? room : first;
+            (void)memcpy( (void*)&obj->buffer[ index ], data, first ); /*MISRAC2012-Rule-11.8 allowed*/
+            (void)memcpy( (void*)obj->buffer, &data[ first ], room - first ); /*MISRAC2012-Rule-11.8 allowed*/
+            qCritical_MemoryBarrier(); /*publish the data before the head*/
+            obj->head = head + room;
+        }
+    }
+    return room;
+}
+/*============================================================================*/
+/*qBool_t qBSBuffer_Write( qBSBuffer_t * const obj, const void *src, const size_t n )
+ 
+Adds n data-bytes to the BSBuffer(Byte-sized Buffer). If there is no room for
+all of them, nothing is added.
+
+Parameters:
+
+    - obj : A pointer to the qBSBuffer(Byte-sized Buffer) object
+    - src : The data to be added
+    - n : The number of bytes to add
+  
+Return value:
+
+    qTrue on success, otherwise returns qFalse
+*/
+qBool_t qBSBuffer_Write( qBSBuffer_t * const obj, const void *src, const size_t n ){
+    qBool_t RetValue = qFalse;
+    if( ( NULL != obj ) && ( n > 0u ) ){
+        if( n <= ( obj->length - qBSBuffer_Count( obj ) ) ){
+            RetValue = ( n == qBSBuffer_WriteUpTo( obj, src, n ) )? qTrue : qFalse;
+        }
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*void* qBSBuffer_GetWriteSpan( const qBSBuffer_t * const obj, size_t * const size )
+ 
+Get the largest contiguous free region at the head of the BSBuffer(Byte-sized 
+Buffer), so it can be filled in place (i.e. by a DMA transfer or a read() call)
+without intermediate copies. The data is not added until qBSBuffer_CommitWrite
+is called. If the free space wraps around the end of the buffer, only the part
+before the wrap is returned, the rest is available after the commit.
+ 
+Parameters:
+
+    - obj : A pointer to the qBSBuffer(Byte-sized Buffer) object
+    - size : The location where the size of the region will be written
+  
+Return value:
+
+    A pointer to the region, or NULL if the BSBuffer is full.
+*/
+void* qBSBuffer_GetWriteSpan( const qBSBuffer_t * const obj, size_t * const size ){
+    void *RetValue = NULL;
+    size_t room, index, contiguous;
+    qIndex_t head;
+    if( ( NULL != obj ) && ( NULL != size ) ){
+        *size = 0u;
+        head = obj->head; /*to avoid side effects*/
+        room = obj->length - (size_t)( head - obj->tail );
+        if( room > 0u ){
+            qCritical_MemoryBarrier(); /*read the tail before the free space is overwritten*/
+            index = head & ( obj->length - 1u ); /*the length is a power of two*/
+            contiguous = obj->length - index;
+            *size = ( room < contiguous )? room : contiguous;
+            RetValue = (void*)&obj->buffer[ index ]; /*MISRAC2012-Rule-11.8 allowed*/
+        }
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qBool_t qBSBuffer_CommitWrite( qBSBuffer_t * const obj, const size_t n )
+ 
+Add the first <n> bytes written in the region obtained with 
+qBSBuffer_GetWriteSpan to the BSBuffer(Byte-sized Buffer).
+ 
+Parameters:
+
+    - obj : A pointer to the qBSBuffer(Byte-sized Buffer) object
+    - n : The number of bytes written in the region
+  
+Return value:
+
+    qTrue on success. qFalse if <n> exceeds the free space.
+*/
+qBool_t qBSBuffer_CommitWrite( qBSBuffer_t * const obj, const size_t n ){
+    qBool_t RetValue = qFalse;
+    qIndex_t head;
+    if( NULL != obj ){
+        head = obj->head; /*to avoid side effects*/
+        if( n <= ( obj->length - (size_t)( head - obj->tail ) ) ){
+            qCritical_MemoryBarrier(); /*publish the data before the head*/
+            obj->head = head + n;
+            RetValue = qTrue;
+        }
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*void* qBSBuffer_GetReadSpan( const qBSBuffer_t * const obj, size_t * const size )
+ 
+Get the largest contiguous region of data at the tail of the BSBuffer
+(Byte-sized Buffer), so it can be drained in place (i.e. by a DMA transfer or
+a write() call) without intermediate copies. The data is not removed until 
+qBSBuffer_ConsumeRead is called. If the data wraps around the end of the 
+buffer, only the part before the wrap is returned, the rest is available 
+after the consume.
+ 
+Parameters:
+
+    - obj : A pointer to the qBSBuffer(Byte-sized Buffer) object
+    - size : The location where the size of the region will be written
+  
+Return value:
+
+    A pointer to the region, or NULL if the BSBuffer is empty.
+*/
+void* qBSBuffer_GetReadSpan( const qBSBuffer_t * const obj, size_t * const size ){
+    void *RetValue = NULL;
+    size_t available, index, contiguous;
+    qIndex_t tail;
+    if( ( NULL != obj ) && ( NULL != size ) ){
+        *size = 0u;
+        tail = obj->tail; /*to avoid side effects*/
+        available = (size_t)( obj->head - tail );
+        if( available > 0u ){
+            qCritical_MemoryBarrier(); /*read the head before the data*/
+            index = tail & ( obj->length - 1u ); /*the length is a power of two*/
+            contiguous = obj->length - index;
+            *size = ( available < contiguous )? available : contiguous;
+            RetValue = (void*)&obj->buffer[ index ]; /*MISRAC2012-Rule-11.8 allowed*/
+        }
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qBool_t qBSBuffer_ConsumeRead( qBSBuffer_t * const obj, const size_t n )
+ 
+Remove the first <n> bytes of the region obtained with qBSBuffer_GetReadSpan 
+from the BSBuffer(Byte-sized Buffer).
+ 
+Parameters:
+
+    - obj : A pointer to the qBSBuffer(Byte-sized Buffer) object
+    - n : The number of bytes drained from the region
+  
+Return value:
+
+    qTrue on success. qFalse if <n> exceeds the available data.
+*/
+qBool_t qBSBuffer_ConsumeRead( qBSBuffer_t * const obj, const size_t n ){
+    qBool_t RetValue = qFalse;
+    qIndex_t tail;
+    if( NULL != obj ){
+        tail = obj->tail; /*to avoid side effects*/
+        if( n <= (size_t)( obj->head - tail ) ){
+            qCritical_MemoryBarrier(); /*finish the access to the data before releasing the space*/
+            obj->tail = tail + n;
+            RetValue = qTrue;
+        }
+    }
+    return RetValue;
+}
+/*============================================================================*/
 /*void qBSBuffer_Init(qBSBuffer_t *const obj, volatile uint8_t *buffer, const qSize_t length){
  
 Initialize the BSBuffer(Byte-sized Buffer)
@@ -188,7 +421,8 @@ Parameters:
 
     - obj : A pointer to the qBSBuffer(Byte-sized Buffer) object
     - buffer: Block of memory or array of data
-    - length: The size of the buffer(Must be a power of two)
+    - length: The size of the buffer(Must be a power of two). Otherwise, only 
+              the largest power of two that fits in the buffer will be used.
   
 */
 void qBSBuffer_Init( qBSBuffer_t * const obj, volatile qUINT8_t *buffer, const size_t length ){
@@ -196,11 +430,7 @@ void qBSBuffer_Init( qBSBuffer_t * const obj, volatile qUINT8_t *buffer, const s
         obj->head = 0u;
         obj->tail = 0u;
         obj->buffer = buffer;
-        #if ( Q_QUEUES == 1 )
-            obj->length = _qQueueValidPowerOfTwo( length );
-        #else
-            obj->length = length;
-        #endif      
+        obj->length = _qBSBuffer_PowerOfTwoBelow( length ); /*the indexes are wrapped with a mask*/
     }
 }
 /*============================================================================*/
@@ -0,0 +1,319 @@
+#include "qchannels.h"
+
+#if ( Q_CHANNELS == 1 )
+
+static size_t qChannelSlot( const qChannel_t * const obj, const size_t index );
+static size_t qChannelAdvance( const qChannel_t * const obj, const size_t index, const size_t n );
+static size_t qChannelItemsBetween( const qChannel_t * const obj, const size_t head, const size_t tail );
+
+/*============================================================================*/
+static size_t qChannelSlot( const qChannel_t * const obj, const size_t index ){
+    return ( index < obj->qPrivate.ItemsCount )? index : ( index - obj->qPrivate.ItemsCount );
+}
+/*============================================================================*/
+static size_t qChannelAdvance( const qChannel_t * const obj, const size_t index, const size_t n ){
+    size_t RetValue = index + n;
+    if( RetValue >= ( 2u*obj->qPrivate.ItemsCount ) ){ /*indexes run over twice the capacity to tell apart full from empty*/
+        RetValue -= 2u*obj->qPrivate.ItemsCount;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+static size_t qChannelItemsBetween( const qChannel_t * const obj, const size_t head, const size_t tail ){
+    return ( head >= tail )? ( head - tail ) : ( head + ( 2u*obj->qPrivate.ItemsCount ) - tail );
+}
+/*============================================================================*/
+/*qBool_t qChannelCreate( qChannel_t * const obj, void *DataArea, size_t ItemSize, size_t ItemsCount )
+
+Create and configures a channel. The RAM used to hold the channel data <DataArea>
+is statically allocated at compile time by the application writer.
+A channel connects exactly one producer with one consumer, that can run on
+different execution contexts (threads, cores or ISRs) without any critical
+section.
+
+Parameters:
+
+    - obj : A pointer to the channel object
+    - DataArea : Data block or array of data. Must hold ItemSize*ItemsCount bytes.
+    - ItemSize : The size of one item in the data block
+    - ItemsCount : The max number of items the channel can hold
+
+Return value:
+
+    qTrue on success, otherwise returns qFalse.
+*/
+qBool_t qChannelCreate( qChannel_t * const obj, void *DataArea, size_t ItemSize, size_t ItemsCount ){
+    qBool_t RetValue = qFalse;
+    if( ( NULL != obj ) && ( NULL != DataArea ) && ( ItemSize > 0u ) && ( ItemsCount > 0u ) ){
+        obj->qPrivate.Storage = (qUINT8_t*)DataArea;
+        obj->qPrivate.ItemSize = ItemSize;
+        obj->qPrivate.ItemsCount = ItemsCount;
+        obj->qPrivate.Head = 0u;
+        obj->qPrivate.Tail = 0u;
+        obj->qPrivate.Wakeup = NULL;
+        obj->qPrivate.WakeupArg = NULL;
+        RetValue = qTrue;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*void qChannelSetWakeup( qChannel_t * const obj, qChannelWakeupFcn_t Wakeup, void *arg )
+
+Set the function that will be invoked by the producer after every successful
+send operation. It can be used to wake up the consumer context when it is
+waiting for events inside the idle task (i.e. writing to an eventfd or
+waking a futex on POSIX systems).
+
+Parameters:
+
+    - obj : A pointer to the channel object
+    - Wakeup : The wake-up function. Should have this prototype:
+               void Function( void *arg ). Pass NULL to disable it.
+    - arg : The argument passed to <Wakeup>
+*/
+void qChannelSetWakeup( qChannel_t * const obj, qChannelWakeupFcn_t Wakeup, void *arg ){
+    if( NULL != obj ){
+        obj->qPrivate.WakeupArg = arg;
+        obj->qPrivate.Wakeup = Wakeup;
+    }
+}
+/*============================================================================*/
+/*size_t qChannelCount( const qChannel_t * const obj )
+
+Returns the number of items in the channel
+
+Parameters:
+
+    - obj : A pointer to the channel object
+
+Return value:
+
+    The number of items in the channel
+*/
+size_t qChannelCount( const qChannel_t * const obj ){
+    size_t RetValue = 0u;
+    if( NULL != obj ){
+        RetValue = qChannelItemsBetween( obj, obj->qPrivate.Head, obj->qPrivate.Tail );
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qBool_t qChannelIsEmpty( const qChannel_t * const obj )
+
+Returns the empty status of the channel
+
+Parameters:
+
+    - obj : A pointer to the channel object
+
+Return value:
+
+    qTrue if the channel is empty, qFalse if it is not.
+*/
+qBool_t qChannelIsEmpty( const qChannel_t * const obj ){
+    return ( 0u == qChannelCount( obj ) )? qTrue : qFalse;
+}
+/*============================================================================*/
+/*qBool_t qChannelIsFull( const qChannel_t * const obj )
+
+Returns the full status of the channel
+
+Parameters:
+
+    - obj : A pointer to the channel object
+
+Return value:
+
+    qTrue if the channel is full, qFalse if it is not.
+*/
+qBool_t qChannelIsFull( const qChannel_t * const obj ){
+    qBool_t RetValue = qFalse;
+    if( NULL != obj ){
+        RetValue = ( obj->qPrivate.ItemsCount == qChannelCount( obj ) )? qTrue : qFalse;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*size_t qChannelSendN( qChannel_t * const obj, const void *Items, size_t n )
+
+Post up to <n> consecutive items to the back of the channel. The items are
+sent by copy using at most two memory copies (before and after the ring wrap).
+Only the producer is allowed to call this function.
+
+Parameters:
+
+    - obj : A pointer to the channel object
+    - Items : A pointer to the items to send
+    - n : The number of items to send
+
+Return value:
+
+    The number of items actually sent.
+*/
+size_t qChannelSendN( qChannel_t * const obj, const void *Items, size_t n ){
+    size_t Head, Slot, First, Room;
+    const qUINT8_t *Src = (const qUINT8_t*)Items;
+
+    if( ( NULL != obj ) && ( NULL != Items ) && ( n > 0u ) ){
+        Head = obj->qPrivate.Head;
+        Room = obj->qPrivate.ItemsCount - qChannelItemsBetween( obj, Head, obj->qPrivate.Tail );
+        qCritical_MemoryBarrier(); /*the consumer must be done with the slots before they are overwritten*/
+        n = ( n > Room )? Room : n;
+        if( n > 0u ){
+            Slot = qChannelSlot( obj, Head );
+            First = obj->qPrivate.ItemsCount - Slot; /*free slots before the wrap*/
+            First = ( First > n )? n : First;
+            (void)memcpy( &obj->qPrivate.Storage[ Slot*obj->qPrivate.ItemSize ], Src, First*obj->qPrivate.ItemSize );
+            if( n > First ){
+                (void)memcpy( obj->qPrivate.Storage, &Src[ First*obj->qPrivate.ItemSize ], ( n - First )*obj->qPrivate.ItemSize );
+            }
+            qCritical_MemoryBarrier(); /*publish the data before the index*/
+            obj->qPrivate.Head = qChannelAdvance( obj, Head, n );
+            if( NULL != obj->qPrivate.Wakeup ){
+                obj->qPrivate.Wakeup( obj->qPrivate.WakeupArg );
+            }
+        }
+    }
+    else{
+        n = 0u;
+    }
+    return n;
+}
+/*============================================================================*/
+/*qBool_t qChannelSendToBack( qChannel_t * const obj, const void *ItemToSend )
+
+Post an item to the back of the channel. The item is sent by copy, not by reference.
+Only the producer is allowed to call this function.
+
+Parameters:
+
+    - obj : A pointer to the channel object
+    - ItemToSend : A pointer to the item that is to be placed on the channel.
+
+Return value:
+
+    qTrue on successful add, qFalse if not added
+*/
+qBool_t qChannelSendToBack( qChannel_t * const obj, const void *ItemToSend ){
+    return ( 1u == qChannelSendN( obj, ItemToSend, 1u ) )? qTrue : qFalse;
+}
+/*============================================================================*/
+/*void* qChannelPeek( const qChannel_t * const obj )
+
+Looks at the item in the front of the channel without removing it. The
+item can be processed in place and then released with qChannelRemoveFront.
+Only the consumer is allowed to call this function.
+
+Parameters:
+
+    - obj : A pointer to the channel object
+
+Return value:
+
+    Pointer to the item, or NULL if there is nothing in the channel
+*/
+void* qChannelPeek( const qChannel_t * const obj ){
+    void *RetValue = NULL;
+    size_t Tail;
+    if( NULL != obj ){
+        Tail = obj->qPrivate.Tail;
+        if( Tail != obj->qPrivate.Head ){
+            qCritical_MemoryBarrier(); /*read the index before the data*/
+            RetValue = &obj->qPrivate.Storage[ qChannelSlot( obj, Tail )*obj->qPrivate.ItemSize ];
+        }
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qBool_t qChannelRemoveFront( qChannel_t * const obj )
+
+Remove the item located at the front of the channel.
+Only the consumer is allowed to call this function.
+
+Parameters:
+
+    - obj : A pointer to the channel object
+
+Return value:
+
+    qTrue if the item was removed, otherwise returns qFalse
+*/
+qBool_t qChannelRemoveFront( qChannel_t * const obj ){
+    qBool_t RetValue = qFalse;
+    size_t Tail;
+    if( NULL != obj ){
+        Tail = obj->qPrivate.Tail;
+        if( Tail != obj->qPrivate.Head ){
+            qCritical_MemoryBarrier(); /*finish any access to the slot before releasing it*/
+            obj->qPrivate.Tail = qChannelAdvance( obj, Tail, 1u );
+            RetValue = qTrue;
+        }
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*size_t qChannelReceiveN( qChannel_t * const obj, void *dest, size_t n )
+
+Receive up to <n> items from the front of the channel (and removes them). The
+items are received by copy using at most two memory copies, so a buffer of
+adequate size must be provided.
+Only the consumer is allowed to call this function.
+
+Parameters:
+
+    - obj : A pointer to the channel object
+    - dest : Pointer to the buffer into which the received items will be copied.
+    - n : The max number of items to receive
+
+Return value:
+
+    The number of items actually received.
+*/
+size_t qChannelReceiveN( qChannel_t * const obj, void *dest, size_t n ){
+    size_t Tail, Slot, First, Available;
+    qUINT8_t *Dst = (qUINT8_t*)dest;
+
+    if( ( NULL != obj ) && ( NULL != dest ) && ( n > 0u ) ){
+        Tail = obj->qPrivate.Tail;
+        Available = qChannelItemsBetween( obj, obj->qPrivate.Head, Tail );
+        qCritical_MemoryBarrier(); /*read the index before the data*/
+        n = ( n > Available )? Available : n;
+        if( n > 0u ){
+            Slot = qChannelSlot( obj, Tail );
+            First = obj->qPrivate.ItemsCount - Slot; /*items before the wrap*/
+            First = ( First > n )? n : First;
+            (void)memcpy( Dst, &obj->qPrivate.Storage[ Slot*obj->qPrivate.ItemSize ], First*obj->qPrivate.ItemSize );
+            if( n > First ){
+                (void)memcpy( &Dst[ First*obj->qPrivate.ItemSize ], obj->qPrivate.Storage, ( n - First )*obj->qPrivate.ItemSize );
+            }
+            qCritical_MemoryBarrier(); /*finish the copy before releasing the slots*/
+            obj->qPrivate.Tail = qChannelAdvance( obj, Tail, n );
+        }
+    }
+    else{
+        n = 0u;
+    }
+    return n;
+}
+/*============================================================================*/
+/*qBool_t qChannelReceive( qChannel_t * const obj, void *dest )
+
+Receive an item from the channel (and removes it). The item is received by
+copy so a buffer of adequate size must be provided.
+Only the consumer is allowed to call this function.
+
+Parameters:
+
+    - obj : A pointer to the channel object
+    - dest : Pointer to the buffer into which the received item will be copied.
+
+Return value:
+
+    qTrue if data was retrieved from the channel, otherwise returns qFalse
+*/
+qBool_t qChannelReceive( qChannel_t * const obj, void *dest ){
+    return ( 1u == qChannelReceiveN( obj, dest, 1u ) )? qTrue : qFalse;
+}
+/*============================================================================*/
+
+#endif /* #if ( Q_CHANNELS == 1 ) */
@@ -111,8 +111,13 @@ Return value:
 */
 qClock_t qClock_GetTick( void ){   
     qGetTickFcn_t TickProvider;
+    qClock_t RetValue;
     TickProvider = GetSysTick;
-	return ( NULL != TickProvider )? TickProvider() : _qSysTick_Epochs_; /*some compilers can deal with function pointers inside structs*/
+	RetValue = ( NULL != TickProvider )? TickProvider() : _qSysTick_Epochs_; /*some compilers can deal with function pointers inside structs*/
+    #if ( Q_REPLAY == 1 )
+        RetValue = __qPrivate_ReplayTick( RetValue ); /*record the value or take it from the replayed stream*/
+    #endif
+    return RetValue;
 }
 /*============================================================================*/
 /*qBool_t qClock_TimeDeadlineCheck( const qClock_t ti, const qClock_t td )( void )
@@ -53,4 +53,30 @@ void qCritical_SetInterruptsED( const qInt_Restorer_t Restorer, const qInt_Disab
     Critical.I_Restorer = Restorer;
     Critical.I_Disable = Disabler;
 }
+/*============================================================================*/
+void __qCritical_CompilerBarrier( void ){
+    /*nothing to do, the external call itself prevents the compiler reordering*/
+}
+/*============================================================================*/
+qBool_t __qCritical_CompareAndSwap( void * volatile *ptr, void *expected, void *desired ){
+    qBool_t RetValue = qFalse;
+    qCritical_Enter();
+    if( expected == *ptr ){
+        *ptr = desired;
+        RetValue = qTrue;
+    }
+    qCritical_Exit();
+    return RetValue;
+}
+/*============================================================================*/
+qBool_t __qCritical_CompareAndSwapSize( volatile size_t *ptr, size_t expected, size_t desired ){
+    qBool_t RetValue = qFalse;
+    qCritical_Enter();
+    if( expected == *ptr ){
+        *ptr = desired;
+        RetValue = qTrue;
+    }
+    qCritical_Exit();
+    return RetValue;
+}
 /*============================================================================*/
\ No newline at end of file
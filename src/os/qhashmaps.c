@@ -0,0 +1,444 @@
+#include "qhashmaps.h"
+
+#define QHASHMAP_REHASH_STEP    ( 2u ) /*< The number of old buckets migrated on every map operation while a resize is in progress*/
+
+static qBool_t qHashMap_IsPowerOfTwo( const size_t n );
+static void** qHashMap_FindLink( const qHashMap_t * const map, const void *key, const size_t hash );
+static void** qHashMap_FindNodeLink( const qHashMap_t * const map, const qHashNode_t * const node );
+static void qHashMap_Link( void ** const Buckets, const size_t BucketCount, qHashNode_t * const node );
+
+/*=========================================================*/
+static qBool_t qHashMap_IsPowerOfTwo( const size_t n ){
+    return ( ( n > 0u ) && ( 0u == ( n & ( n - 1u ) ) ) )? qTrue : qFalse;
+}
+/*=========================================================*/
+static void qHashMap_Link( void ** const Buckets, const size_t BucketCount, qHashNode_t * const node ){
+    void **Bucket = &Buckets[ node->__qHashValue & ( BucketCount - 1u ) ];
+    node->__qHashNext = *Bucket;
+    *Bucket = node;
+}
+/*=========================================================*/
+static void** qHashMap_FindLink( const qHashMap_t * const map, const void *key, const size_t hash ){
+    void **Link = NULL;
+    void **iLink;
+    qHashNode_t *iNode;
+    void **Table[ 2 ];
+    size_t Counts[ 2 ], i;
+
+    Table[ 0 ] = map->qPrivate.Buckets;
+    Counts[ 0 ] = map->qPrivate.BucketCount;
+    Table[ 1 ] = map->qPrivate.OldBuckets; /*the node could still be waiting to be migrated*/
+    Counts[ 1 ] = map->qPrivate.OldBucketCount;
+    for( i = 0u ; ( i < 2u ) && ( NULL == Link ) && ( NULL != Table[ i ] ) ; i++ ){
+        for( iLink = &Table[ i ][ hash & ( Counts[ i ] - 1u ) ] ; NULL != *iLink ; iLink = &iNode->__qHashNext ){
+            iNode = (qHashNode_t*)*iLink;
+            if( ( hash == iNode->__qHashValue ) && ( qTrue == map->qPrivate.EqualFcn( key, iNode->__qHashKey ) ) ){
+                Link = iLink;
+                break;
+            }
+        }
+    }
+    return Link;
+}
+/*=========================================================*/
+static void** qHashMap_FindNodeLink( const qHashMap_t * const map, const qHashNode_t * const node ){
+    void **Link = NULL;
+    void **iLink;
+    void **Table[ 2 ];
+    size_t Counts[ 2 ], i;
+
+    Table[ 0 ] = map->qPrivate.Buckets;
+    Counts[ 0 ] = map->qPrivate.BucketCount;
+    Table[ 1 ] = map->qPrivate.OldBuckets;
+    Counts[ 1 ] = map->qPrivate.OldBucketCount;
+    for( i = 0u ; ( i < 2u ) && ( NULL == Link ) && ( NULL != Table[ i ] ) ; i++ ){
+        for( iLink = &Table[ i ][ node->__qHashValue & ( Counts[ i ] - 1u ) ] ; NULL != *iLink ; iLink = &( (qHashNode_t*)*iLink )->__qHashNext ){
+            if( node == *iLink ){
+                Link = iLink;
+                break;
+            }
+        }
+    }
+    return Link;
+}
+/*=========================================================*/
+/*qBool_t qHashMap_Setup( qHashMap_t * const map, void **Buckets, const size_t BucketCount, const qHashFcn_t HashFcn, const qHashEqualFcn_t EqualFcn )
+
+Setup a hash map.
+
+Parameters:
+
+    - map : A pointer to the hash map object.
+    - Buckets : An array of <BucketCount> pointers, provided by the application,
+                that will hold the buckets of the map.
+    - BucketCount : The number of buckets. Must be a power of two.
+    - HashFcn : The function that computes the hash of a key. Should have this
+                prototype:  size_t Function( const void *key )
+                The functions qHashMap_StringHash and qHashMap_U32Hash can be
+                used for NULL-terminated strings and qUINT32_t keys.
+    - EqualFcn : The function that compares two keys. Should have this prototype:
+                 qBool_t Function( const void *key1, const void *key2 )
+                 and return qTrue when both keys are equal. The functions
+                 qHashMap_StringEqual and qHashMap_U32Equal can be used for
+                 NULL-terminated strings and qUINT32_t keys.
+
+Return value:
+
+    qTrue on success, otherwise returns qFalse.
+*/
+qBool_t qHashMap_Setup( qHashMap_t * const map, void **Buckets, const size_t BucketCount, const qHashFcn_t HashFcn, const qHashEqualFcn_t EqualFcn ){
+    qBool_t RetValue = qFalse;
+    size_t i;
+
+    if( ( NULL != map ) && ( NULL != Buckets ) && ( NULL != HashFcn ) && ( NULL != EqualFcn ) && qHashMap_IsPowerOfTwo( BucketCount ) ){
+        for( i = 0u ; i < BucketCount ; i++ ){
+            Buckets[ i ] = NULL;
+        }
+        map->qPrivate.Buckets = Buckets;
+        map->qPrivate.BucketCount = BucketCount;
+        map->qPrivate.OldBuckets = NULL;
+        map->qPrivate.OldBucketCount = 0u;
+        map->qPrivate.MigrateIndex = 0u;
+        map->qPrivate.Count = 0u;
+        map->qPrivate.Walking = 0u;
+        map->qPrivate.HashFcn = HashFcn;
+        map->qPrivate.EqualFcn = EqualFcn;
+        RetValue = qTrue;
+    }
+    return RetValue;
+}
+/*=========================================================*/
+/*qBool_t qHashMap_Insert( qHashMap_t * const map, void * const node, const void *key )
+
+Insert a node into the map.
+
+Parameters:
+
+    - map : A pointer to the hash map object.
+    - node : A pointer to the node to be inserted. The node must not belong
+             to another map.
+    - key : A pointer to the key of the node. The key is stored by reference,
+            so it must remain valid (and unchanged) while the node belongs to
+            the map. Usually it points to a member of the node itself.
+
+Return value:
+
+    qTrue on success. qFalse if the node belongs to a map or if another node
+    with the same key is already in the map.
+*/
+qBool_t qHashMap_Insert( qHashMap_t * const map, void * const node, const void *key ){
+    qBool_t RetValue = qFalse;
+    qHashNode_t *xNode = (qHashNode_t*)node;
+    size_t Hash;
+
+    if( ( NULL != map ) && ( NULL != xNode ) && ( NULL != key ) ){
+        (void)qHashMap_Rehash( map, QHASHMAP_REHASH_STEP );
+        if( NULL == xNode->__qHashContainer ){
+            Hash = map->qPrivate.HashFcn( key );
+            if( NULL == qHashMap_FindLink( map, key, Hash ) ){
+                xNode->__qHashKey = key;
+                xNode->__qHashValue = Hash;
+                xNode->__qHashContainer = map;
+                qHashMap_Link( map->qPrivate.Buckets, map->qPrivate.BucketCount, xNode );
+                map->qPrivate.Count++;
+                RetValue = qTrue;
+            }
+        }
+    }
+    return RetValue;
+}
+/*=========================================================*/
+/*void* qHashMap_Find( qHashMap_t * const map, const void *key )
+
+Find the node with the given key. The map is not modified, so this can be
+used while the map is being walked with qHashMap_ForEach.
+
+Parameters:
+
+    - map : A pointer to the hash map object.
+    - key : A pointer to the key.
+
+Return value:
+
+    A pointer to the node. NULL if there is no node with the given key.
+*/
+void* qHashMap_Find( const qHashMap_t * const map, const void *key ){
+    void *RetValue = NULL;
+    void **Link;
+
+    if( ( NULL != map ) && ( NULL != key ) ){
+        Link = qHashMap_FindLink( map, key, map->qPrivate.HashFcn( key ) );
+        if( NULL != Link ){
+            RetValue = *Link;
+        }
+    }
+    return RetValue;
+}
+/*=========================================================*/
+/*qBool_t qHashMap_Remove( qHashMap_t * const map, void * const node )
+
+Remove a node from the map.
+
+Parameters:
+
+    - map : A pointer to the hash map object.
+    - node : A pointer to the node to be removed.
+
+Return value:
+
+    qTrue on success. qFalse if the node does not belong to the map.
+*/
+qBool_t qHashMap_Remove( qHashMap_t * const map, void * const node ){
+    qBool_t RetValue = qFalse;
+    qHashNode_t *xNode = (qHashNode_t*)node;
+    void **Link;
+
+    if( ( NULL != map ) && ( NULL != xNode ) ){
+        if( map == xNode->__qHashContainer ){
+            Link = qHashMap_FindNodeLink( map, xNode );
+            if( NULL != Link ){
+                *Link = xNode->__qHashNext;
+                xNode->__qHashNext = NULL;
+                xNode->__qHashContainer = NULL;
+                map->qPrivate.Count--;
+                RetValue = qTrue;
+            }
+        }
+        (void)qHashMap_Rehash( map, QHASHMAP_REHASH_STEP );
+    }
+    return RetValue;
+}
+/*=========================================================*/
+/*void* qHashMap_RemoveKey( qHashMap_t * const map, const void *key )
+
+Remove the node with the given key.
+
+Parameters:
+
+    - map : A pointer to the hash map object.
+    - key : A pointer to the key.
+
+Return value:
+
+    A pointer to the removed node. NULL if there is no node with the given key.
+*/
+void* qHashMap_RemoveKey( qHashMap_t * const map, const void *key ){
+    void *RetValue = qHashMap_Find( map, key );
+
+    if( NULL != RetValue ){
+        (void)qHashMap_Remove( map, RetValue );
+    }
+    return RetValue;
+}
+/*=========================================================*/
+/*size_t qHashMap_Count( const qHashMap_t * const map )
+
+Returns the number of nodes in the map.
+*/
+size_t qHashMap_Count( const qHashMap_t * const map ){
+    return ( NULL != map )? map->qPrivate.Count : 0u;
+}
+/*=========================================================*/
+/*size_t qHashMap_BucketCount( const qHashMap_t * const map )
+
+Returns the number of buckets of the map (the target array if a resize
+is in progress). The ratio qHashMap_Count/qHashMap_BucketCount (load factor)
+can be used to decide when to resize the map.
+*/
+size_t qHashMap_BucketCount( const qHashMap_t * const map ){
+    return ( NULL != map )? map->qPrivate.BucketCount : 0u;
+}
+/*=========================================================*/
+/*qBool_t qHashMap_Resize( qHashMap_t * const map, void **Buckets, const size_t BucketCount )
+
+Start moving the map to a new bucket array. The nodes are migrated
+incrementally by the subsequent map operations (or explicitly with
+qHashMap_Rehash). The previous array must not be reused until
+qHashMap_IsResizing returns qFalse.
+
+Parameters:
+
+    - map : A pointer to the hash map object.
+    - Buckets : The new array of <BucketCount> pointers.
+    - BucketCount : The number of buckets. Must be a power of two.
+
+Return value:
+
+    qTrue on success. qFalse if the arguments are invalid or if a previous
+    resize is still in progress.
+*/
+qBool_t qHashMap_Resize( qHashMap_t * const map, void **Buckets, const size_t BucketCount ){
+    qBool_t RetValue = qFalse;
+    size_t i;
+
+    if( ( NULL != map ) && ( NULL != Buckets ) && ( Buckets != map->qPrivate.Buckets ) && qHashMap_IsPowerOfTwo( BucketCount ) ){
+        if( NULL == map->qPrivate.OldBuckets ){
+            for( i = 0u ; i < BucketCount ; i++ ){
+                Buckets[ i ] = NULL;
+            }
+            map->qPrivate.OldBuckets = map->qPrivate.Buckets;
+            map->qPrivate.OldBucketCount = map->qPrivate.BucketCount;
+            map->qPrivate.MigrateIndex = 0u;
+            map->qPrivate.Buckets = Buckets;
+            map->qPrivate.BucketCount = BucketCount;
+            (void)qHashMap_Rehash( map, ( 0u == map->qPrivate.Count )? 0u : QHASHMAP_REHASH_STEP );
+            RetValue = qTrue;
+        }
+    }
+    return RetValue;
+}
+/*=========================================================*/
+/*qBool_t qHashMap_Rehash( qHashMap_t * const map, size_t steps )
+
+Make progress on a resize in progress.
+
+Parameters:
+
+    - map : A pointer to the hash map object.
+    - steps : The max number of old buckets to migrate. Pass 0(zero) to
+              finish the migration.
+
+Note: The migration is suspended while the map is being walked with 
+      qHashMap_ForEach, so the chains are never moved under the walk.
+
+Return value:
+
+    qTrue if there is no resize in progress after the call, otherwise
+    returns qFalse.
+*/
+qBool_t qHashMap_Rehash( qHashMap_t * const map, size_t steps ){
+    qBool_t RetValue = qFalse;
+    qHashNode_t *iNode, *Next;
+
+    if( NULL != map ){
+        while( ( NULL != map->qPrivate.OldBuckets ) && ( 0u == map->qPrivate.Walking ) ){
+            for( iNode = (qHashNode_t*)map->qPrivate.OldBuckets[ map->qPrivate.MigrateIndex ] ; NULL != iNode ; iNode = Next ){
+                Next = (qHashNode_t*)iNode->__qHashNext;
+                qHashMap_Link( map->qPrivate.Buckets, map->qPrivate.BucketCount, iNode );
+            }
+            map->qPrivate.OldBuckets[ map->qPrivate.MigrateIndex ] = NULL;
+            if( ++map->qPrivate.MigrateIndex >= map->qPrivate.OldBucketCount ){
+                map->qPrivate.OldBuckets = NULL; /*the old array is now free*/
+                map->qPrivate.OldBucketCount = 0u;
+                map->qPrivate.MigrateIndex = 0u;
+            }
+            if( ( steps > 0u ) && ( 0u == --steps ) ){
+                break;
+            }
+        }
+        RetValue = ( NULL == map->qPrivate.OldBuckets )? qTrue : qFalse;
+    }
+    return RetValue;
+}
+/*=========================================================*/
+/*qBool_t qHashMap_IsResizing( const qHashMap_t * const map )
+
+Returns qTrue if a resize is in progress, otherwise returns qFalse.
+*/
+qBool_t qHashMap_IsResizing( const qHashMap_t * const map ){
+    return ( ( NULL != map ) && ( NULL != map->qPrivate.OldBuckets ) )? qTrue : qFalse;
+}
+/*=========================================================*/
+/*qBool_t qHashMap_ForEach( qHashMap_t * const map, const qListNodeFcn_t Fcn, void *arg )
+
+Operate on each node of the map. The nodes are visited in no particular
+order. The current node can be removed from <Fcn>. The incremental migration
+of a resize in progress is suspended during the walk, so every node that 
+is not removed is visited exactly once. Nodes inserted from <Fcn> may or 
+may not be visited.
+
+Parameters:
+
+    - map : A pointer to the hash map object.
+    - Fcn : The function to perform over the node.
+            Should have this prototype:
+            qBool_t Function( void* Node, void *arg, qList_WalkStage_t stage )
+
+            If <Function> returns qTrue, the walk through loop
+            will be terminated.
+
+    - arg : Argument passed to <Fcn>
+
+Return value:
+
+    qTrue if the walk through was early terminated, otherwise returns qFalse.
+*/
+qBool_t qHashMap_ForEach( qHashMap_t * const map, const qListNodeFcn_t Fcn, void *arg ){
+    qBool_t RetValue = qFalse;
+    qHashNode_t *iNode, *Next;
+    void **Table[ 2 ];
+    size_t Counts[ 2 ], i, j;
+
+    if( ( NULL != map ) && ( NULL != Fcn ) ){
+        Table[ 0 ] = map->qPrivate.Buckets;
+        Counts[ 0 ] = map->qPrivate.BucketCount;
+        Table[ 1 ] = map->qPrivate.OldBuckets;
+        Counts[ 1 ] = map->qPrivate.OldBucketCount;
+        map->qPrivate.Walking++;
+        RetValue = Fcn( NULL, arg, qList_WalkInit );
+        for( i = 0u ; ( i < 2u ) && ( qFalse == RetValue ) && ( NULL != Table[ i ] ) ; i++ ){
+            for( j = 0u ; ( j < Counts[ i ] ) && ( qFalse == RetValue ) ; j++ ){
+                for( iNode = (qHashNode_t*)Table[ i ][ j ] ; NULL != iNode ; iNode = Next ){
+                    Next = (qHashNode_t*)iNode->__qHashNext; /*the node can be removed in the walk throught*/
+                    RetValue = Fcn( iNode, arg, qList_WalkThrough );
+                    if( RetValue ){
+                        break;
+                    }
+                }
+            }
+        }
+        if( qFalse == RetValue ){
+            RetValue = Fcn( NULL, arg, qList_WalkEnd );
+        }
+        map->qPrivate.Walking--;
+    }
+    return RetValue;
+}
+/*=========================================================*/
+/*size_t qHashMap_StringHash( const void *key )
+
+Hash function for NULL-terminated strings (FNV-1a).
+*/
+size_t qHashMap_StringHash( const void *key ){
+    const qUINT8_t *s = (const qUINT8_t*)key;
+    qUINT32_t Hash = 2166136261uL;
+
+    while( (qUINT8_t)'\0' != *s ){
+        Hash ^= (qUINT32_t)*s++;
+        Hash *= 16777619uL;
+    }
+    return (size_t)Hash;
+}
+/*=========================================================*/
+/*qBool_t qHashMap_StringEqual( const void *key1, const void *key2 )
+
+Key comparison function for NULL-terminated strings.
+*/
+qBool_t qHashMap_StringEqual( const void *key1, const void *key2 ){
+    return ( 0 == strcmp( (const char*)key1, (const char*)key2 ) )? qTrue : qFalse;
+}
+/*=========================================================*/
+/*size_t qHashMap_U32Hash( const void *key )
+
+Hash function for keys of type qUINT32_t (the key is a pointer to the
+value). The bits are mixed so that sequential IDs spread over the buckets.
+*/
+size_t qHashMap_U32Hash( const void *key ){
+    qUINT32_t Hash = *( (const qUINT32_t*)key );
+
+    Hash ^= Hash >> 16;
+    Hash *= 0x85EBCA6BuL;
+    Hash ^= Hash >> 13;
+    Hash *= 0xC2B2AE35uL;
+    Hash ^= Hash >> 16;
+    return (size_t)Hash;
+}
+/*=========================================================*/
+/*qBool_t qHashMap_U32Equal( const void *key1, const void *key2 )
+
+Key comparison function for keys of type qUINT32_t.
+*/
+qBool_t qHashMap_U32Equal( const void *key1, const void *key2 ){
+    return ( *( (const qUINT32_t*)key1 ) == *( (const qUINT32_t*)key2 ) )? qTrue : qFalse;
+}
+/*=========================================================*/
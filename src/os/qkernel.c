@@ -22,6 +22,18 @@ typedef struct{
     void *eventdata;
 }qNotificationSpreader_t;
 
+#if ( Q_SCHEDULER_LOAD == 1 )
+typedef struct{
+    qGetTickFcn_t Counter;  /*< The high resolution counter used for the measurements. */
+    qClock_t Window;        /*< The length of the measurement window. */
+    qClock_t WindowStart;   /*< The counter value at the beginning of the current window. */
+    qClock_t TasksTime;     /*< The time spent in task callbacks during the current window. */
+    qClock_t IdleTime;      /*< The time spent in cycles that dispatched no task during the current window. */
+    qUINT8_t Restarts;      /*< Changed by qSchedulerSetLoadCounter, so a measurement in progress starts again at the new window. */
+    qLoad_t Last;           /*< The results of the last completed window. */
+}qLoadMeter_t;
+#endif
+
 typedef struct{ /*KCB(Kernel Control Block) definition*/
     qList_t CoreLists[ Q_PRIORITY_LEVELS + 2 ];
     qTaskFcn_t IDLECallback;                            /*< The callback function that represents the idle-task activities. */
@@ -42,6 +54,20 @@ typedef struct{ /*KCB(Kernel Control Block) definition*/
     #if ( Q_PRESERVE_TASK_ENTRY_ORDER == 1)
         size_t TaskEntries;
     #endif
+    #if ( Q_SCHEDULER_LOAD == 1 )
+        qLoadMeter_t Load;                              /*< The CPU load measurement data. */
+    #endif
+    #if ( Q_TASK_POOL_SIZE > 0 )
+        qList_t TaskPoolFree;                           /*< The list of task objects available for qSchedulerCreateTask. */
+        qTask_t TaskPool[ Q_TASK_POOL_SIZE ];           /*< The storage area of the task pool. */
+    #endif
+    #if ( Q_TASK_REGISTRY == 1 )
+        qHashMap_t TaskIDs;                             /*< The registered tasks keyed by ID. */
+        qHashMap_t TaskNames;                           /*< The registered tasks keyed by name. */
+        void *TaskIDBuckets[ Q_TASK_REGISTRY_BUCKETS ];
+        void *TaskNameBuckets[ Q_TASK_REGISTRY_BUCKETS ];
+        qUINT32_t LastTaskID;                           /*< The last ID assigned by qSchedulerAdd_Task. */
+    #endif
 }qKernelControlBlock_t;
 
 /*=========================== Kernel Control Block ===========================*/
@@ -53,16 +79,39 @@ static qList_t *ReadyList = &kernel.CoreLists[ 0 ];
 /*=============================== Private Methods ============================*/
 static qBool_t _qScheduler_TaskDeadLineReached( qTask_t * const task);
 static qBool_t qOS_CheckIfReady( void *node, void *arg, qList_WalkStage_t stage );
+static qBool_t _qScheduler_CheckReadyTasks( void );
 static qBool_t qOS_Dispatch( void *node, void *arg, qList_WalkStage_t stage );    
 
 #define _qAbs( x )    ((((x)<0) && ((x)!=qPeriodic))? -(x) : (x))
 
 #if ( Q_PRIO_QUEUE_SIZE > 0 )  
     static void _qScheduler_PriorityQueue_ClearIndex( qIndex_t IndexToClear );
-    static void _qScheduler_PriorityQueue_CleanUp( const qTask_t * task );
     static qTask_t* _qScheduler_PriorityQueueGet( void );
 #endif
 
+#if ( Q_SCHEDULER_LOAD == 1 )
+    static qClock_t _qScheduler_LoadCounter( void );
+    static qUINT16_t _qScheduler_PerMille( const qClock_t part, const qClock_t total );
+    static void _qScheduler_LoadUpdate( void );
+    static qBool_t _qScheduler_LoadLatchTask( void *node, void *arg, qList_WalkStage_t stage );
+    static qBool_t _qScheduler_LoadResetTask( void *node, void *arg, qList_WalkStage_t stage );
+#endif
+
+#if ( Q_TASK_POOL_SIZE > 0 )
+    static qBool_t _qScheduler_TaskPoolOwns( const qTask_t * const Task );
+    static void _qScheduler_TaskPoolRelease( qTask_t * const Task );
+#endif
+
+#if ( Q_TASK_REGISTRY == 1 )
+    typedef struct{
+        qListNodeFcn_t Fcn;
+        void *arg;
+    }qRegistryWalk_t;
+    static qBool_t _qScheduler_RegistryAdd( qTask_t * const Task );
+    static void _qScheduler_RegistryRemove( qTask_t * const Task );
+    static qBool_t _qScheduler_RegistryWalk( void *node, void *arg, qList_WalkStage_t stage );
+#endif
+
 #if ( Q_ALLOW_SCHEDULER_RELEASE == 1 )
     static void _qTriggerReleaseSchedEvent( void );
 #endif
@@ -136,6 +185,30 @@ Parameters:
     #if ( Q_PRESERVE_TASK_ENTRY_ORDER == 1)
         kernel.TaskEntries = (size_t)0;
     #endif
+    #if ( Q_SCHEDULER_LOAD == 1 )
+        kernel.Load.Counter = NULL;
+        kernel.Load.Window = (qClock_t)Q_SCHEDULER_LOAD_WINDOW;
+        kernel.Load.WindowStart = 0uL;
+        kernel.Load.TasksTime = 0uL;
+        kernel.Load.IdleTime = 0uL;
+        kernel.Load.Restarts = 0u;
+        kernel.Load.Last.System = 0u;
+        kernel.Load.Last.Tasks = 0u;
+        kernel.Load.Last.Idle = 0u;
+        kernel.Load.Last.Overhead = 0u;
+    #endif
+    #if ( Q_TASK_POOL_SIZE > 0 )
+        qList_Initialize( &kernel.TaskPoolFree );
+        for( i = 0u ; i < (qIndex_t)Q_TASK_POOL_SIZE ; i++){
+            kernel.TaskPool[i].qPrivate.container = NULL;
+            (void)qList_Insert( &kernel.TaskPoolFree, &kernel.TaskPool[i], qList_AtBack );
+        }
+    #endif
+    #if ( Q_TASK_REGISTRY == 1 )
+        (void)qHashMap_Setup( &kernel.TaskIDs, kernel.TaskIDBuckets, (size_t)Q_TASK_REGISTRY_BUCKETS, qHashMap_U32Hash, qHashMap_U32Equal );
+        (void)qHashMap_Setup( &kernel.TaskNames, kernel.TaskNameBuckets, (size_t)Q_TASK_REGISTRY_BUCKETS, qHashMap_StringHash, qHashMap_StringEqual );
+        kernel.LastTaskID = 0uL;
+    #endif
     kernel.CurrentRunningTask = NULL;
     qClock_SetTickProvider( TickProvider );
 }
@@ -219,15 +292,6 @@ qBool_t qSchedulerSpreadNotification( void *eventdata, const qTaskNotifyMode_t m
 }
 /*============================================================================*/
 #if ( Q_PRIO_QUEUE_SIZE > 0 )  
-static void _qScheduler_PriorityQueue_CleanUp( const qTask_t * task ){
-    qIndex_t i;
-    for( i = 1u ; ( i < (qIndex_t)Q_PRIO_QUEUE_SIZE ) ; i++){ 
-        if( kernel.QueueStack[ i ].Task == task ){
-            _qScheduler_PriorityQueue_ClearIndex( i );
-        }
-    }
-}
-/*============================================================================*/
 static void _qScheduler_PriorityQueue_ClearIndex( qIndex_t IndexToClear ){
     qIndex_t j;
     qBase_t QueueIndex;
@@ -248,11 +312,16 @@ qBool_t _qScheduler_PriorityQueue_Insert(qTask_t * const Task, void *data){
         qBase_t CurrentQueueIndex;
         QueueMaxIndex = Q_PRIO_QUEUE_SIZE - 1; /*to avoid side effects */
         CurrentQueueIndex = kernel.QueueIndex; /*to avoid side effects */
-        if( ( NULL != Task )  && ( CurrentQueueIndex < QueueMaxIndex) ) {/*check if data can be queued*/
-            tmp.QueueData = data;
-            tmp.Task = Task;
-            kernel.QueueStack[ ++kernel.QueueIndex ] = tmp; /*insert task and the corresponding eventdata to the queue*/
-            RetValue = qTrue;
+        if( NULL != Task ){
+            if( CurrentQueueIndex < QueueMaxIndex ) {/*check if data can be queued*/
+                tmp.QueueData = data;
+                tmp.Task = Task;
+                kernel.QueueStack[ ++kernel.QueueIndex ] = tmp; /*insert task and the corresponding eventdata to the queue*/
+                RetValue = qTrue;
+            }
+            else{
+                qHook_NotificationQueueOverflow( Task, data );
+            }
         }
         return RetValue;
     #else
@@ -269,10 +338,7 @@ static qTask_t* _qScheduler_PriorityQueueGet( void ){
     if( kernel.QueueIndex >= 0 ){ /*queue has elements*/
         qCritical_Enter(); 
         MaxPriorityValue = kernel.QueueStack[0].Task->qPrivate.Priority;
-        for( i = 1u ; ( i < (qIndex_t)Q_PRIO_QUEUE_SIZE ) ; i++){  /*walk through the queue to find the task with the highest priority*/
-            if( NULL == kernel.QueueStack[i].Task ){ /* tail is reached */
-                break;
-            }
+        for( i = 1u ; (qBase_t)i <= kernel.QueueIndex ; i++){  /*walk through the queue to find the task with the highest priority*/
             if( kernel.QueueStack[i].Task->qPrivate.Priority > MaxPriorityValue ){ /*check if the queued task has the max priority value*/
                 MaxPriorityValue = kernel.QueueStack[i].Task->qPrivate.Priority; /*Reassign the max value*/
                 IndexTaskToExtract = i;  /*save the index*/
@@ -333,7 +399,7 @@ qBool_t qSchedulerAdd_Task( qTask_t * const Task, qTaskFcn_t CallbackFcn, qPrior
         __qPrivate_TaskModifyFlags( Task,
                                  __QTASK_BIT_INIT | __QTASK_BIT_QUEUE_RECEIVER | 
                                  __QTASK_BIT_QUEUE_FULL | __QTASK_BIT_QUEUE_COUNT | 
-                                 __QTASK_BIT_QUEUE_EMPTY | __QTASK_BIT_REMOVE_REQUEST, 
+                                 __QTASK_BIT_QUEUE_EMPTY | __QTASK_BIT_RELEASE, 
                                  qFalse);
         __qPrivate_TaskModifyFlags( Task, __QTASK_BIT_SHUTDOWN | __QTASK_BIT_ENABLED, qTrue );  /*task will be awaken and enabled*/ 
         qTaskSetState( Task, InitialState );
@@ -341,8 +407,19 @@ qBool_t qSchedulerAdd_Task( qTask_t * const Task, qTaskFcn_t CallbackFcn, qPrior
         #if ( Q_TASK_COUNT_CYCLES == 1 )
             Task->qPrivate.Cycles = 0uL;
         #endif
+        #if ( Q_SCHEDULER_LOAD == 1 )
+            Task->qPrivate.BusyTime = 0uL;
+            Task->qPrivate.Load = 0u;
+        #endif
         #if ( Q_QUEUES == 1)
             Task->qPrivate.Queue = NULL;
+            Task->qPrivate.PQueue = NULL;
+            #if ( Q_QUEUE_SET_SIZE > 0 )
+                Task->qPrivate.QueueSet = NULL;
+            #endif
+        #endif
+        #if ( Q_CHANNELS == 1 )
+            Task->qPrivate.Channel = NULL;
         #endif
         #if ( Q_FSM == 1)
             Task->qPrivate.StateMachine = NULL;
@@ -351,6 +428,14 @@ qBool_t qSchedulerAdd_Task( qTask_t * const Task, qTaskFcn_t CallbackFcn, qPrior
             Task->qPrivate.Entry = kernel.TaskEntries++;
         #endif
         RetValue = qList_Insert( WaitingList, Task, qList_AtBack ); 
+        #if ( Q_TASK_REGISTRY == 1 )
+            if( qTrue == RetValue ){
+                RetValue = _qScheduler_RegistryAdd( Task );
+                if( qFalse == RetValue ){ /*the name is already in use*/
+                    (void)qList_RemoveItself( Task );
+                }
+            }
+        #endif
     }
     return RetValue;  
 }
@@ -479,7 +564,16 @@ static void qScheduler_ATParserNotifyFcn(struct _qATParser_s * const Parser){
 /*============================================================================*/
 /*qBool_t qSchedulerRemoveTask(qTask_t *Task)
 
-Remove the task from the scheduling scheme.
+Remove the task from the scheduling scheme. The task is unlinked immediately
+from the list that holds it and any pending queued notification of the task
+gets discarded.
+
+Note: This API can be used from a task callback. The kernel walks its own 
+lists taking always the front node, so a removal never invalidates the walk.
+However, the task should not be removed while the application iterates the 
+list that holds it with qList_ForEach, because the walk keeps a reference to
+the adjacent node. Do not call it from an interrupt: the scheduler moves and
+sorts its lists outside of a critical section.
 
 Parameters:
 
@@ -491,12 +585,235 @@ Return value:
     */
 qBool_t qSchedulerRemoveTask( qTask_t * const Task ){
     qBool_t RetValue = qFalse;
+    #if ( Q_TASK_POOL_SIZE > 0 )
+        if( ( NULL != Task ) && ( &kernel.TaskPoolFree != Task->qPrivate.container ) ){ /*a task released to the pool isn't scheduled*/
+    #else
+        if( NULL != Task ){
+    #endif
+        #if ( Q_PRIO_QUEUE_SIZE > 0 )  
+            qIndex_t i = 0u;
+        #endif
+        qCritical_Enter(); 
+        (void)qList_RemoveItself( Task ); /*the node knows its own container, no walk is required*/
+        #if ( Q_PRIO_QUEUE_SIZE > 0 )  
+            while( (qBase_t)i <= kernel.QueueIndex ){ /*purge the queued notifications, so they don't hold slots of the priority queue*/
+                if( Task == kernel.QueueStack[ i ].Task ){
+                    _qScheduler_PriorityQueue_ClearIndex( i ); /*the remaining items are shifted to this position*/
+                }
+                else{
+                    i++;
+                }
+            }
+        #endif
+        qCritical_Exit();
+        #if ( Q_TASK_REGISTRY == 1 )
+            _qScheduler_RegistryRemove( Task );
+        #endif
+        RetValue = qTrue;
+    }
+    return RetValue;
+}
+#if ( Q_TASK_POOL_SIZE > 0 )
+/*============================================================================*/
+/*qTask_t* qSchedulerCreateTask(qTaskFcn_t CallbackFcn, qPriority_t Priority, qTime_t Time, qIteration_t nExecutions, qState_t InitialState, void* arg)
+
+Take a task object from the kernel task pool and add it to the scheduling 
+scheme. The pool is a fixed-capacity storage area of Q_TASK_POOL_SIZE tasks,
+so the heap is never used. See qSchedulerAdd_Task for the parameters 
+description.
+
+Return value:
+
+    A pointer to the created task. NULL if the pool is exhausted.
+*/
+qTask_t* qSchedulerCreateTask( qTaskFcn_t CallbackFcn, qPriority_t Priority, qTime_t Time, qIteration_t nExecutions, qState_t InitialState, void* arg ){
+    qTask_t *Task;
+
+    Task = (qTask_t*)qList_Remove( &kernel.TaskPoolFree, NULL, qList_AtFront );
     if( NULL != Task ){
-        __qPrivate_TaskModifyFlags( Task, __QTASK_BIT_REMOVE_REQUEST, qTrue );
+        if( qFalse == qSchedulerAdd_Task( Task, CallbackFcn, Priority, Time, nExecutions, InitialState, arg ) ){
+            _qScheduler_TaskPoolRelease( Task );
+            Task = NULL;
+        }
+    }
+    return Task;
+}
+/*============================================================================*/
+/*qBool_t qSchedulerDestroyTask(qTask_t *Task)
+
+Remove a task created with qSchedulerCreateTask from the scheduling scheme
+and give it back to the kernel task pool. A task can destroy itself, in that 
+case, the object returns to the pool after its callback ends.
+
+Parameters:
+
+    - Task : A pointer to the task node.
+     
+Return value:
+
+    Returns qTrue if success, otherwise returns qFalse.
+*/
+qBool_t qSchedulerDestroyTask( qTask_t * const Task ){
+    qBool_t RetValue = qFalse;
+    if( _qScheduler_TaskPoolOwns( Task ) && ( &kernel.TaskPoolFree != Task->qPrivate.container ) ){
+        (void)qSchedulerRemoveTask( Task );
+        if( kernel.CurrentRunningTask == Task ){
+            __qPrivate_TaskModifyFlags( Task, __QTASK_BIT_RELEASE, qTrue ); /*the dispatcher will release it*/
+        }
+        else{
+            _qScheduler_TaskPoolRelease( Task );
+        }
         RetValue = qTrue;
     }
     return RetValue;
 }
+/*============================================================================*/
+static qBool_t _qScheduler_TaskPoolOwns( const qTask_t * const Task ){
+    return ( ( Task >= &kernel.TaskPool[ 0 ] ) && ( Task <= &kernel.TaskPool[ Q_TASK_POOL_SIZE - 1 ] ) )? qTrue : qFalse;
+}
+/*============================================================================*/
+static void _qScheduler_TaskPoolRelease( qTask_t * const Task ){
+    __qPrivate_TaskModifyFlags( Task, __QTASK_BIT_RELEASE, qFalse );
+    #if ( Q_TASK_REGISTRY == 1 )
+        Task->qPrivate.Name = NULL; /*the next owner of the object sets its own name*/
+    #endif
+    (void)qList_Insert( &kernel.TaskPoolFree, Task, qList_AtBack ); /*release at the back, so recently destroyed objects are reused last*/
+}
+#endif /* #if ( Q_TASK_POOL_SIZE > 0 ) */
+#if ( Q_TASK_REGISTRY == 1 )
+/*============================================================================*/
+/*qTask_t* qSchedulerFindTask( const char *Name )
+
+Find a task in the scheduling scheme by its name (see qTaskSetName). The 
+lookup is performed using a hash map, so the cost does not depend on the 
+number of tasks.
+
+Parameters:
+
+    - Name : The name of the task.
+
+Return value:
+
+    A pointer to the task. NULL if there is no task with the given name.
+*/
+qTask_t* qSchedulerFindTask( const char *Name ){
+    qTask_t *Task = NULL;
+    void *Node = qHashMap_Find( &kernel.TaskNames, Name );
+
+    if( NULL != Node ){
+        Task = qHashMap_Entry( Node, qTask_t, qPrivate.NameNode );
+    }
+    return Task;
+}
+/*============================================================================*/
+/*qTask_t* qSchedulerFindTaskByID( const qUINT32_t ID )
+
+Find a task in the scheduling scheme by the ID assigned by qSchedulerAdd_Task
+(see qTaskGetID).
+
+Parameters:
+
+    - ID : The identifier of the task.
+
+Return value:
+
+    A pointer to the task. NULL if there is no task with the given ID.
+*/
+qTask_t* qSchedulerFindTaskByID( const qUINT32_t ID ){
+    qTask_t *Task = NULL;
+    void *Node = qHashMap_Find( &kernel.TaskIDs, &ID );
+
+    if( NULL != Node ){
+        Task = qHashMap_Entry( Node, qTask_t, qPrivate.IDNode );
+    }
+    return Task;
+}
+/*============================================================================*/
+/*qBool_t qSchedulerForEachTask( const qListNodeFcn_t Fcn, void *arg )
+
+Operate on each task of the scheduling scheme. Unlike walking the kernel
+lists, the registry is not modified by the scheduler, so this function can
+be called at any time (including from a task callback) and every task is
+visited exactly once, in no particular order.
+
+Parameters:
+
+    - Fcn : The function to perform over the task.
+            Should have this prototype:
+            qBool_t Function( void* Task, void *arg, qList_WalkStage_t stage )
+
+            If <Function> returns qTrue, the walk through loop
+            will be terminated. Tasks can't be added or removed 
+            inside <Function>.
+
+    - arg : Argument passed to <Fcn>
+
+Return value:
+
+    qTrue if the walk through was early terminated, otherwise returns qFalse.
+*/
+qBool_t qSchedulerForEachTask( const qListNodeFcn_t Fcn, void *arg ){
+    qBool_t RetValue = qFalse;
+    qRegistryWalk_t Walk;
+
+    if( NULL != Fcn ){
+        Walk.Fcn = Fcn;
+        Walk.arg = arg;
+        RetValue = qHashMap_ForEach( &kernel.TaskIDs, _qScheduler_RegistryWalk, &Walk );
+    }
+    return RetValue;
+}
+/*============================================================================*/
+static qBool_t _qScheduler_RegistryWalk( void *node, void *arg, qList_WalkStage_t stage ){
+    qRegistryWalk_t *Walk = (qRegistryWalk_t*)arg;
+    qTask_t *Task = NULL;
+
+    if( NULL != node ){
+        Task = qHashMap_Entry( node, qTask_t, qPrivate.IDNode );
+    }
+    return Walk->Fcn( Task, Walk->arg, stage );
+}
+/*============================================================================*/
+static qBool_t _qScheduler_RegistryAdd( qTask_t * const Task ){
+    qBool_t RetValue = qTrue;
+
+    do{ /*skip the zero value and the IDs still in use after a wrap-around*/
+        kernel.LastTaskID++;
+    }while( ( 0uL == kernel.LastTaskID ) || ( NULL != qHashMap_Find( &kernel.TaskIDs, &kernel.LastTaskID ) ) );
+    Task->qPrivate.ID = kernel.LastTaskID;
+    (void)qHashMap_Insert( &kernel.TaskIDs, &Task->qPrivate.IDNode, &Task->qPrivate.ID );
+    if( NULL != Task->qPrivate.Name ){
+        RetValue = qHashMap_Insert( &kernel.TaskNames, &Task->qPrivate.NameNode, Task->qPrivate.Name );
+        if( qFalse == RetValue ){
+            (void)qHashMap_Remove( &kernel.TaskIDs, &Task->qPrivate.IDNode );
+        }
+    }
+    return RetValue;
+}
+/*============================================================================*/
+static void _qScheduler_RegistryRemove( qTask_t * const Task ){
+    (void)qHashMap_Remove( &kernel.TaskIDs, &Task->qPrivate.IDNode );
+    (void)qHashMap_Remove( &kernel.TaskNames, &Task->qPrivate.NameNode );
+}
+/*============================================================================*/
+qBool_t _qScheduler_RegistryRename( qTask_t * const Task, const char *Name ){
+    qBool_t RetValue = qTrue;
+
+    if( &kernel.TaskIDs == Task->qPrivate.IDNode.__qHashContainer ){ /*the task is registered, update the name map*/
+        (void)qHashMap_Remove( &kernel.TaskNames, &Task->qPrivate.NameNode );
+        if( NULL != Name ){
+            RetValue = qHashMap_Insert( &kernel.TaskNames, &Task->qPrivate.NameNode, Name );
+        }
+        if( ( qFalse == RetValue ) && ( NULL != Task->qPrivate.Name ) ){ /*keep the previous name*/
+            (void)qHashMap_Insert( &kernel.TaskNames, &Task->qPrivate.NameNode, Task->qPrivate.Name );
+        }
+    }
+    if( qTrue == RetValue ){
+        Task->qPrivate.Name = Name;
+    }
+    return RetValue;
+}
+#endif /* #if ( Q_TASK_REGISTRY == 1 ) */
 #if ( Q_QUEUES == 1)
 /*============================================================================*/
 static qTrigger_t _qScheduler_CheckQueueEvents( const qTask_t * const Task ){
@@ -505,15 +822,22 @@ static qTrigger_t _qScheduler_CheckQueueEvents( const qTask_t * const Task ){
     qBool_t IsFull, IsEmpty;
     size_t CurrentQueueCount;
 
-    if( NULL != Task->qPrivate.Queue){
+    if( ( NULL != Task->qPrivate.Queue ) || ( NULL != Task->qPrivate.PQueue ) ){
         FullFlag = __qPrivate_TaskGetFlag( Task, __QTASK_BIT_QUEUE_FULL );
         CountFlag = __qPrivate_TaskGetFlag( Task, __QTASK_BIT_QUEUE_COUNT );
         ReceiverFlag = __qPrivate_TaskGetFlag( Task, __QTASK_BIT_QUEUE_RECEIVER );
         EmptyFlag = __qPrivate_TaskGetFlag( Task, __QTASK_BIT_QUEUE_EMPTY );
         
-        CurrentQueueCount = qQueueCount( Task->qPrivate.Queue ); /*to avoid side effects*/
-        IsFull = qQueueIsFull( Task->qPrivate.Queue ); /*to avoid side effects*/
-        IsEmpty = qQueueIsEmpty( Task->qPrivate.Queue ); /*to avoid side effects*/
+        if( NULL != Task->qPrivate.Queue ){
+            CurrentQueueCount = qQueueCount( Task->qPrivate.Queue ); /*to avoid side effects*/
+            IsFull = qQueueIsFull( Task->qPrivate.Queue ); /*to avoid side effects*/
+            IsEmpty = qQueueIsEmpty( Task->qPrivate.Queue ); /*to avoid side effects*/
+        }
+        else{
+            CurrentQueueCount = qPQueueCount( Task->qPrivate.PQueue );
+            IsFull = qPQueueIsFull( Task->qPrivate.PQueue );
+            IsEmpty = qPQueueIsEmpty( Task->qPrivate.PQueue );
+        }
         /*check the queue events in the corresponding precedence order*/
         if( FullFlag && IsFull ){        
             RetValue =  byQueueFull;
@@ -563,21 +887,40 @@ pool has been defined.
 void qSchedulerRun( void ){
     qIndex_t xPriorityListIndex; 
     qList_t *xList;
+    #if ( Q_SCHEDULER_LOAD == 1 )
+        qClock_t CycleStart;
+        qUINT8_t CycleRestarts;
+    #endif
 
+    #if ( Q_SCHEDULER_LOAD == 1 )
+        kernel.Load.WindowStart = _qScheduler_LoadCounter();
+    #endif
     do{           
-        if( qList_ForEach( WaitingList, qOS_CheckIfReady, NULL, QLIST_FORWARD ) ){ /*check for ready tasks in the waiting list*/
+        #if ( Q_SCHEDULER_LOAD == 1 )
+            CycleStart = _qScheduler_LoadCounter();
+            CycleRestarts = kernel.Load.Restarts;
+        #endif
+        if( _qScheduler_CheckReadyTasks() ){ /*check for ready tasks in the waiting list*/
             xPriorityListIndex = (qIndex_t)Q_PRIORITY_LEVELS - (qIndex_t)1;
             do{ /*loop every ready-list in descending priority order*/
                 xList = &ReadyList[ xPriorityListIndex ]; /*get the target ready-list*/
-                if( xList->size > (size_t)0 ){ /*check if the target list has items*/
-                    (void)qList_ForEach( xList, qOS_Dispatch, xList, QLIST_FORWARD ); /*dispatch every task in this list*/
+                while( NULL != xList->head ){ /*dispatch every task in this list, a callback can remove any other task from it*/
+                    (void)qOS_Dispatch( xList->head, xList, QLIST_WALKTHROUGH );
                 }
             }while( (qIndex_t)0 != xPriorityListIndex-- );
         }
         else{ /*no task in the scheme is ready*/
+            qHook_IdleEnter();
             if( NULL != kernel.IDLECallback ){ /*check if the idle-task is available*/
                 (void)qOS_Dispatch( NULL, NULL, QLIST_WALKTHROUGH );
             }
+            qHook_IdleExit();
+            #if ( Q_SCHEDULER_LOAD == 1 )
+                if( CycleRestarts != kernel.Load.Restarts ){ /*the idle-task restarted the measurement*/
+                    CycleStart = kernel.Load.WindowStart;
+                }
+                kernel.Load.IdleTime += _qScheduler_LoadCounter() - CycleStart; /*a cycle that dispatched no task is idle, even without the idle-task*/
+            #endif
         }
         if( SuspendedList->size > (size_t)0 ){  /*check if the suspended list has items*/
             qList_Move( WaitingList, SuspendedList, qList_AtBack ); /*move the remaining suspended tasks to the waiting list*/
@@ -585,6 +928,9 @@ void qSchedulerRun( void ){
                 qList_Sort( WaitingList, _qOS_EntryOrderPreserver );
             #endif
         }
+        #if ( Q_SCHEDULER_LOAD == 1 )
+            _qScheduler_LoadUpdate(); /*all the tasks are in the waiting list at this point*/
+        #endif
     }
     #if ( Q_ALLOW_SCHEDULER_RELEASE == 1 )
         while( qFalse == __QKERNEL_COREFLAG_GET( kernel.Flag, __QKERNEL_BIT_RELEASESCHED ) ); /*scheduling end-point*/ 
@@ -603,6 +949,24 @@ static qBool_t _qOS_EntryOrderPreserver(const void *n1, const void *n2){
 }
 #endif
 /*============================================================================*/
+static qBool_t _qScheduler_CheckReadyTasks( void ){
+    qBool_t RetValue;
+    qNode_t *xNode;
+    /*
+    Every check moves the front task to another list, so the walk always takes
+    the front node instead of keeping a reference to the adjacent one. This way
+    a task removed from an interrupt can't break the walk.
+    */
+    RetValue = qOS_CheckIfReady( NULL, NULL, QLIST_WALKINIT );
+    while( ( qFalse == RetValue ) && ( NULL != ( xNode = WaitingList->head ) ) ){
+        RetValue = qOS_CheckIfReady( xNode, NULL, QLIST_WALKTHROUGH );
+    }
+    if( qFalse == RetValue ){
+        RetValue = qOS_CheckIfReady( NULL, NULL, QLIST_WALKEND );
+    }
+    return RetValue;
+}
+/*============================================================================*/
 static qBool_t qOS_CheckIfReady( void *node, void *arg, qList_WalkStage_t stage ){
     qTask_t *xTask;
     qList_t *xList;
@@ -652,6 +1016,18 @@ static qBool_t qOS_CheckIfReady( void *node, void *arg, qList_WalkStage_t stage
                 xReady = qTrue;
             }
             #endif
+            #if ( ( Q_QUEUES == 1 ) && ( Q_QUEUE_SET_SIZE > 0 ) )
+            else if( qTrue == qQueueSetIsReady( xTask->qPrivate.QueueSet ) ){ /*a member of the set has items*/
+                xTask->qPrivate.Trigger = byQueueSet;
+                xReady = qTrue;
+            }
+            #endif
+            #if ( Q_CHANNELS == 1 )
+            else if( ( NULL != xTask->qPrivate.Channel ) && ( qFalse == qChannelIsEmpty( xTask->qPrivate.Channel ) ) ){ /*items sent from another context*/
+                xTask->qPrivate.Trigger = byChannelReceiver;
+                xReady = qTrue;
+            }
+            #endif
             else if( xTask->qPrivate.Notification > (qNotifier_t)0 ){   /*The last check will be if the task has an async event*/
                 xTask->qPrivate.Trigger = byNotificationSimple;  
                 xReady = qTrue;            
@@ -665,20 +1041,19 @@ static qBool_t qOS_CheckIfReady( void *node, void *arg, qList_WalkStage_t stage
                 /*the task has no available events, put it in a suspended state*/        
             }
         }
-        (void)qList_Remove( WaitingList, NULL, QLIST_ATFRONT ); 
-
-        if( __qPrivate_TaskGetFlag( xTask, __QTASK_BIT_REMOVE_REQUEST) ){ /*check if the task get a removal request*/
-            #if ( Q_PRIO_QUEUE_SIZE > 0 )  
-                qCritical_Enter(); 
-                _qScheduler_PriorityQueue_CleanUp( xTask ); /*clean any entry of this task from the priority queue */
-                qCritical_Exit();
-            #endif
-            __qPrivate_TaskModifyFlags( xTask, __QTASK_BIT_REMOVE_REQUEST, qFalse );  /*clear the removal request*/
+        if( qTriggerNULL != xTask->qPrivate.Trigger ){
+            qHook_TriggerDetected( xTask, xTask->qPrivate.Trigger );
+            xList = &ReadyList[ xTask->qPrivate.Priority ];
         }
         else{
-            xList = ( qTriggerNULL != xTask->qPrivate.Trigger )? &ReadyList[ xTask->qPrivate.Priority ] : SuspendedList;
+            xList = SuspendedList;
+        }
+        qCritical_Enter();
+        if( WaitingList == xTask->qPrivate.container ){ /*the task could be removed from an interrupt during the check*/
+            (void)qList_RemoveItself( xTask ); 
             (void)qList_Insert( xList, xTask, QLIST_ATBACK );
         }
+        qCritical_Exit();
     }
     else if( QLIST_WALKEND == stage ){ 
         RetValue = xReady;
@@ -695,6 +1070,15 @@ static qBool_t qOS_Dispatch( void *node, void *arg, qList_WalkStage_t stage ){
     qTrigger_t Event = byNoReadyTasks;
     qIteration_t TaskIteration;
     qTaskFcn_t TaskActivities;
+    #if ( Q_SCHEDULER_LOAD == 1 )
+        qClock_t StartTime, BusyTime;
+        qUINT8_t Restarts;
+    #endif
+    #if ( Q_QUEUES == 1)
+        void *QueueSlot = NULL;
+        qQueue_t *HeldQueue = NULL;
+        qPQueue_t *HeldPQueue = NULL;
+    #endif
 
     xList = (qList_t*)arg;
     
@@ -723,10 +1107,28 @@ static qBool_t qOS_Dispatch( void *node, void *arg, qList_WalkStage_t stage ){
                     break;
                 #if ( Q_QUEUES == 1)    
                     case byQueueReceiver:
-                        kernel.EventInfo.EventData = qQueuePeek( Task->qPrivate.Queue ); /*the EventData will point to the RBuffer front-data*/
+                        if( NULL != Task->qPrivate.Queue ){
+                            HeldQueue = Task->qPrivate.Queue; /*the callback could detach it*/
+                            QueueSlot = qQueuePeekSlot( HeldQueue ); /*the item is processed in place*/
+                        }
+                        else{
+                            HeldPQueue = Task->qPrivate.PQueue; /*the callback could detach it*/
+                            QueueSlot = qPQueueReceiveSlot( HeldPQueue ); /*the slot is held, so a newer item with more priority can't take its place*/
+                        }
+                        kernel.EventInfo.EventData = QueueSlot; /*the EventData will point to the queue front-slot*/
                         break;
                     case byQueueFull: case byQueueCount: case byQueueEmpty: 
-                        kernel.EventInfo.EventData = (void*)Task->qPrivate.Queue;  /*the EventData will point to the the linked RingBuffer*/
+                        kernel.EventInfo.EventData = ( NULL != Task->qPrivate.Queue )? (void*)Task->qPrivate.Queue : (void*)Task->qPrivate.PQueue;  /*the EventData will point to the the linked RingBuffer*/
+                        break;
+                    #if ( Q_QUEUE_SET_SIZE > 0 )
+                        case byQueueSet:
+                            kernel.EventInfo.EventData = (void*)qQueueSetSelect( Task->qPrivate.QueueSet ); /*the member that holds items*/
+                            break;
+                    #endif
+                #endif
+                #if ( Q_CHANNELS == 1 )
+                    case byChannelReceiver:
+                        kernel.EventInfo.EventData = qChannelPeek( Task->qPrivate.Channel ); /*the item is processed in place*/
                         break;
                 #endif
                 #if ( Q_PRIO_QUEUE_SIZE > 0 )  
@@ -747,8 +1149,17 @@ static qBool_t qOS_Dispatch( void *node, void *arg, qList_WalkStage_t stage ){
             kernel.EventInfo.TaskData = Task->qPrivate.TaskData;
             kernel.CurrentRunningTask = Task; /*needed for qTaskSelf()*/
             TaskActivities = Task->qPrivate.Callback;
-            (void)qList_Remove( xList, NULL, qList_AtFront );
-            (void)qList_Insert( WaitingList, Task, QLIST_ATBACK );  
+            qCritical_Enter();
+            if( xList == Task->qPrivate.container ){ /*the task could be removed from an interrupt before the dispatch*/
+                (void)qList_RemoveItself( Task );
+                (void)qList_Insert( WaitingList, Task, QLIST_ATBACK );  
+            }
+            qCritical_Exit();
+            qHook_PreDispatch( Task, &kernel.EventInfo );
+            #if ( Q_SCHEDULER_LOAD == 1 )
+                StartTime = _qScheduler_LoadCounter();
+                Restarts = kernel.Load.Restarts;
+            #endif
 
             #if ( Q_FSM == 1)
                 if ( ( NULL != Task->qPrivate.StateMachine ) && ( __qFSMCallbackMode == Task->qPrivate.Callback ) ){
@@ -765,12 +1176,31 @@ static qBool_t qOS_Dispatch( void *node, void *arg, qList_WalkStage_t stage ){
                     TaskActivities( &kernel.EventInfo ); /*else, just launch the callback function*/ 
                 }     
             #endif
+            #if ( Q_SCHEDULER_LOAD == 1 )
+                if( Restarts != kernel.Load.Restarts ){ /*the callback restarted the measurement, the counter may be another one*/
+                    StartTime = kernel.Load.WindowStart;
+                }
+                BusyTime = _qScheduler_LoadCounter() - StartTime;
+                Task->qPrivate.BusyTime += BusyTime;
+                kernel.Load.TasksTime += BusyTime;
+            #endif
+            qHook_PostDispatch( Task, &kernel.EventInfo );
             kernel.CurrentRunningTask = NULL;
             #if ( Q_QUEUES == 1) 
                 if( byQueueReceiver == Event){
-                    (void)qQueueRemoveFront( Task->qPrivate.Queue );  /*remove the data from the Queue, if the event was byQueueDequeue*/
+                    if( NULL != HeldPQueue ){
+                        (void)qPQueueRelease( HeldPQueue, QueueSlot );
+                    }
+                    else{
+                        (void)qQueueRelease( HeldQueue, QueueSlot );  /*release the front-slot in the queue it was taken from*/
+                    }
                 } 
             #endif
+            #if ( Q_CHANNELS == 1 )
+                if( byChannelReceiver == Event ){
+                    (void)qChannelRemoveFront( Task->qPrivate.Channel ); /*release the slot to the producer*/
+                }
+            #endif
             __qPrivate_TaskModifyFlags( Task, __QTASK_BIT_INIT, qTrue ); /*set the init flag*/
             kernel.EventInfo.FirstIteration = qFalse;
             kernel.EventInfo.LastIteration =  qFalse; 
@@ -779,6 +1209,11 @@ static qBool_t qOS_Dispatch( void *node, void *arg, qList_WalkStage_t stage ){
                 Task->qPrivate.Cycles++; /*increase the task cycles value*/
             #endif
             Task->qPrivate.Trigger = qTriggerNULL;
+            #if ( Q_TASK_POOL_SIZE > 0 )
+                if( __qPrivate_TaskGetFlag( Task, __QTASK_BIT_RELEASE ) ){ /*the task destroyed itself*/
+                    _qScheduler_TaskPoolRelease( Task );
+                }
+            #endif
         }
         else{ /*run the idle*/
             kernel.EventInfo.FirstCall = (qFalse == __QKERNEL_COREFLAG_GET( kernel.Flag, __QKERNEL_BIT_FCALLIDLE ) )? qTrue : qFalse;
@@ -828,10 +1263,131 @@ qStateGlobal_t qScheduler_GetTaskGlobalState( const qTask_t * const Task){
         else if( NULL == xList ){
             /*undefined*/  
         }
+        #if ( Q_TASK_POOL_SIZE > 0 )
+        else if( &kernel.TaskPoolFree == xList ){
+            /*undefined, the task object is free*/  
+        }
+        #endif
         else{
             RetValue = qReady;      /*by discard it must be ready*/
         }
     }
     return RetValue;
 }
-/*============================================================================*/
\ No newline at end of file
+/*============================================================================*/
+#if ( Q_SCHEDULER_LOAD == 1 )
+/*============================================================================*/
+/*void qSchedulerSetLoadCounter( const qGetTickFcn_t Counter, const qClock_t Window )
+
+Set the counter and the window used to measure the CPU load. The load is 
+computed from the time spent in the task callbacks, the idle cycles and the
+scheduler itself, over consecutive windows of <Window> counts. A cycle of the
+scheduler that dispatched no task is accounted as idle time, including the
+readiness checks and the idle callback (if any).
+
+Parameters:
+
+    - Counter : A function that returns a free-running counter with a 
+                resolution good enough to time a single callback (i.e. a
+                hardware cycle counter). If NULL, the scheduler tick is used.
+    - Window : The length of the measurement window in counts of <Counter>.
+               A zero value keeps the current window.
+
+The current window is discarded, including the busy time of every task, and 
+a new one starts immediately. It can be called from a task callback. In that 
+case, the time spent by the calling task is measured from this point.
+*/
+void qSchedulerSetLoadCounter( const qGetTickFcn_t Counter, const qClock_t Window ){
+    qIndex_t i;
+
+    kernel.Load.Counter = Counter;
+    if( Window > 0uL ){
+        kernel.Load.Window = Window;
+    }
+    kernel.Load.TasksTime = 0uL;
+    kernel.Load.IdleTime = 0uL;
+    for( i = 0u ; i < (qIndex_t)( Q_PRIORITY_LEVELS + 2 ) ; i++ ){ /*the tasks can be in any of the kernel lists*/
+        (void)qList_ForEach( &kernel.CoreLists[ i ], _qScheduler_LoadResetTask, NULL, QLIST_FORWARD );
+    }
+    kernel.Load.Restarts++;
+    kernel.Load.WindowStart = _qScheduler_LoadCounter();
+}
+/*============================================================================*/
+/*qUINT16_t qSchedulerGetLoad( qLoad_t * const Detail )
+
+Retrieve the CPU load measured in the last completed window. Use qTaskGetLoad 
+to obtain the per-task breakdown.
+
+Parameters:
+
+    - Detail : A pointer to a qLoad_t object where the load detail (tasks, 
+               idle and scheduler overhead) will be written. Pass NULL if
+               not required.
+
+Return value:
+
+    The system load in per-mille (0 to 1000). This is the time not spent
+    in idle cycles.
+*/
+qUINT16_t qSchedulerGetLoad( qLoad_t * const Detail ){
+    if( NULL != Detail ){
+        *Detail = kernel.Load.Last;
+    }
+    return kernel.Load.Last.System;
+}
+/*============================================================================*/
+static qClock_t _qScheduler_LoadCounter( void ){
+    qGetTickFcn_t Counter;
+    Counter = kernel.Load.Counter; /*some compilers can deal with function pointers inside structs*/
+    return ( NULL != Counter )? Counter() : qClock_GetTick();
+}
+/*============================================================================*/
+static qUINT16_t _qScheduler_PerMille( const qClock_t part, const qClock_t total ){
+    qClock_t RetValue = 1000uL;
+    if( part < total ){
+        if( total > ( 0xFFFFFFFFuL/1000uL ) ){ /*prevent the overflow of part*1000*/
+            RetValue = part/( total/1000uL );
+        }
+        else{
+            RetValue = ( part*1000uL )/total;
+        }
+    }
+    return (qUINT16_t)( ( RetValue > 1000uL )? 1000uL : RetValue );
+}
+/*============================================================================*/
+static void _qScheduler_LoadUpdate( void ){
+    qClock_t Elapsed, Busy;
+
+    Elapsed = _qScheduler_LoadCounter() - kernel.Load.WindowStart;
+    if( Elapsed >= kernel.Load.Window ){ /*the window is complete, latch the results*/
+        Busy = kernel.Load.TasksTime + kernel.Load.IdleTime;
+        kernel.Load.Last.Tasks = _qScheduler_PerMille( kernel.Load.TasksTime, Elapsed );
+        kernel.Load.Last.Idle = _qScheduler_PerMille( kernel.Load.IdleTime, Elapsed );
+        kernel.Load.Last.Overhead = ( Busy < Elapsed )? _qScheduler_PerMille( Elapsed - Busy, Elapsed ) : 0u;
+        kernel.Load.Last.System = (qUINT16_t)1000u - kernel.Load.Last.Idle;
+        (void)qList_ForEach( WaitingList, _qScheduler_LoadLatchTask, &Elapsed, QLIST_FORWARD );
+        kernel.Load.TasksTime = 0uL;
+        kernel.Load.IdleTime = 0uL;
+        kernel.Load.WindowStart += Elapsed;
+    }
+}
+/*============================================================================*/
+static qBool_t _qScheduler_LoadLatchTask( void *node, void *arg, qList_WalkStage_t stage ){
+    qTask_t *xTask;
+    if( QLIST_WALKTHROUGH == stage ){
+        xTask = (qTask_t*)node;
+        xTask->qPrivate.Load = _qScheduler_PerMille( xTask->qPrivate.BusyTime, *((qClock_t*)arg) );
+        xTask->qPrivate.BusyTime = 0uL;
+    }
+    return qFalse;
+}
+/*============================================================================*/
+static qBool_t _qScheduler_LoadResetTask( void *node, void *arg, qList_WalkStage_t stage ){
+    (void)arg;
+    if( QLIST_WALKTHROUGH == stage ){
+        ( (qTask_t*)node )->qPrivate.BusyTime = 0uL;
+    }
+    return qFalse;
+}
+#endif /* #if ( Q_SCHEDULER_LOAD == 1 ) */
+/*============================================================================*/
@@ -8,12 +8,30 @@ static qNode_t* qList_RemoveFront( qList_t * const list );
 static qNode_t* qList_RemoveBack( qList_t * const list );
 
 static qNode_t* qList_GetiNode( const qList_t *const list, const qListPosition_t position );
+static void qList_LinkAfter( qList_t * const list, qNode_t * const node, qNode_t * const after );
+static void qList_LinkRange( qList_t * const list, qNode_t * const first, qNode_t * const last, qNode_t * const after, const size_t count );
+static void qList_UnlinkRange( qList_t * const list, qNode_t * const first, qNode_t * const last, const size_t count );
+static void qList_SetRangeContainer( qNode_t *first, const qNode_t * const last, qList_t * const container );
 
 static qListMemAllocator_t qListMalloc = NULL; 
 static qListMemFree_t qListFree = NULL; 
 
+static qBool_t qList_DynamicEnabled( const qList_t * const list );
+static void* qList_NodeAlloc( const qList_t * const list, const size_t size );
+static void qList_NodeFree( void * const node );
+#if ( Q_LIST_POOLS == 1 )
+    typedef size_t qListAddress_t;
+    typedef struct{
+        qListPool_t *Owner;     /*< The pool that provides the block. NULL if the block was taken from the heap. */
+        qBool_t Free;           /*< qTrue while the block is in the free list of its owner. */
+    }qListBlockHeader_t;
+    #define QLIST_POOL_ALIGN( x )   ( ( (size_t)(x) + ( (size_t)Q_BYTE_ALIGNMENT - (size_t)1 ) ) & ~( (size_t)Q_BYTE_ALIGNMENT - (size_t)1 ) )
+    #define QLIST_HEADER_SIZE       QLIST_POOL_ALIGN( sizeof(qListBlockHeader_t) )
+    #define QLIST_BLOCK_HEADER( b ) ( (qListBlockHeader_t*)( (qListAddress_t)(b) - QLIST_HEADER_SIZE ) )
+    static void qListPool_AddChunk( qListPool_t * const pool, void *Area, size_t AreaSize );
+#endif
+
 static qNode_t* __qNode_Forward( const qNode_t *const node );
-static qBool_t qList_ChangeContainer( void *node, void *newcontainer, qList_WalkStage_t stage );
 
 /*============================================================================*/
 /*void qList_Initialize(qList_t *list)
@@ -31,6 +49,9 @@ void qList_Initialize( qList_t * const list ){
         list->head = NULL;
         list->tail = NULL;
         list->size = 0u;
+        #if ( Q_LIST_POOLS == 1 )
+            list->pool = NULL;
+        #endif
     }
 }
 /*=========================================================*/
@@ -92,6 +113,64 @@ static qNode_t* qList_GetiNode( const qList_t *const list, const qListPosition_t
     return iNode;
 }
 /*=========================================================*/
+static void qList_LinkAfter( qList_t * const list, qNode_t * const node, qNode_t * const after ){
+    qList_LinkRange( list, node, node, after, (size_t)1 );
+    node->container = list;
+}
+/*=========================================================*/
+static void qList_LinkRange( qList_t * const list, qNode_t * const first, qNode_t * const last, qNode_t * const after, const size_t count ){
+    if( NULL == after ){ /*link at front*/
+        first->prev = NULL;
+        last->next = list->head;
+        if( NULL != list->head ){
+            list->head->prev = last;
+        }
+        else{
+            list->tail = last;
+        }
+        list->head = first;
+    }
+    else{
+        last->next = after->next;
+        first->prev = after;
+        if( NULL != after->next ){
+            after->next->prev = last;
+        }
+        else{
+            list->tail = last;
+        }
+        after->next = first;
+    }
+    list->size += count;
+}
+/*=========================================================*/
+static void qList_UnlinkRange( qList_t * const list, qNode_t * const first, qNode_t * const last, const size_t count ){
+    if( NULL != first->prev ){
+        first->prev->next = last->next;
+    }
+    else{
+        list->head = last->next;
+    }
+    if( NULL != last->next ){
+        last->next->prev = first->prev;
+    }
+    else{
+        list->tail = first->prev;
+    }
+    first->prev = NULL;
+    last->next = NULL;
+    list->size -= count;
+}
+/*=========================================================*/
+static void qList_SetRangeContainer( qNode_t *first, const qNode_t * const last, qList_t * const container ){
+    for( ; NULL != first ; first = first->next ){
+        first->container = container;
+        if( last == first ){
+            break;
+        }
+    }
+}
+/*=========================================================*/
 /*qBool_t qList_Insert(qList_t * const list, const void * const node, const qListPosition_t position)
  
 Insert an item into the list.
@@ -245,7 +324,9 @@ void* qList_Remove( qList_t * const list, void * const node, const qListPosition
 Moves(or merge) the entire list pointed by <source> to the list pointed by 
 <destination> at location specified by <position> 
 After the move operation, this function leaves empty the list pointed 
-by <source>.
+by <source>. Only the links at the boundaries are rewritten, but every moved
+node gets its container updated, so the operation takes O(n) time, where n 
+is the length of <source>.
 
 Parameters:
 
@@ -265,44 +346,105 @@ qBool_t qList_Move( qList_t *const destination, qList_t *const source, const qLi
     qBool_t RetValue = qFalse;
     qNode_t *iNode;
 
-    if( ( NULL != destination ) && ( NULL != source ) && ( position >= (qListPosition_t)(-1) )  ) {    
+    if( ( NULL != destination ) && ( NULL != source ) && ( destination != source ) && ( position >= (qListPosition_t)(-1) )  ) {    
         if( NULL != source->head){ /*source has items*/
             RetValue = qTrue;
-            (void)qList_ForEach( source, qList_ChangeContainer, destination, QLIST_FORWARD );          
-            if( NULL == destination->head ){ /*destination is empty*/
-                destination->head = source->head;
-                destination->tail = source->tail;
-            }
-            else if( qList_AtFront == position ){
-                source->tail->next = destination->head;
-                destination->head->prev = source->tail;
-                destination->head = source->head;
+            qList_SetRangeContainer( source->head, source->tail, destination );
+            if( ( NULL == destination->head ) || ( qList_AtFront == position ) ){
+                iNode = NULL;
             }
             else if( position >= ( (qListPosition_t)destination->size - 1 ) ){
-                destination->tail->next = source->head;
-                source->head->prev = destination->tail;
-                destination->tail = source->tail;
+                iNode = destination->tail;
             }
             else{ /*insert the new list after the position*/
                 iNode = qList_GetiNode( destination, position );
-                source->tail->next = iNode->next; 
-                source->head->prev = iNode;
-                iNode->next = source->head;
             }
-            destination->size += source->size;
-            qList_Initialize( source ); /*clean up source*/
+            qList_LinkRange( destination, source->head, source->tail, iNode, source->size );
+            source->head = NULL; /*clean up source, keeping its attributes*/
+            source->tail = NULL;
+            source->size = 0u;
         }
     }
     return RetValue;
 }
 /*=========================================================*/
-static qBool_t qList_ChangeContainer( void *node, void *newcontainer, qList_WalkStage_t stage ){
-    qNode_t *xNode;
-    if( qList_WalkThrough == stage ){
-        xNode = (qNode_t*)node;
-        xNode->container = newcontainer;
+/*qBool_t qList_SpliceRange( qList_t *const destination, void * const after, qList_t *const source, void * const first, void * const last )
+
+Moves the range of consecutive nodes [<first>, <last>] from the list pointed
+by <source> to the list pointed by <destination>, right after the node 
+<after>. The operation takes O(k) time, where k is the number of nodes in 
+the range: the range is walked once to count the nodes, update their 
+container and verify that <last> follows <first>. If <last> does not follow 
+<first>, the walk reaches the end of <source> and the containers are 
+restored before the call fails. Only the links at the boundaries of the 
+range are rewritten.
+
+Parameters:
+
+    - destination : Pointer to the list where the nodes are to be moved.
+    - after : A node of <destination>. The range is inserted after it. 
+              Pass NULL to insert the range at the front.
+    - source : Pointer to the list that holds the range.
+    - first : The first node of the range.
+    - last : The last node of the range. It must be <first> or a node that
+             follows <first> in <source>. 
+
+Return value:
+
+    qTrue if the splice operation is performed successfully, otherwise 
+    returns qFalse   
+*/
+qBool_t qList_SpliceRange( qList_t *const destination, void * const after, qList_t *const source, void * const first, void * const last ){
+    qBool_t RetValue = qFalse;
+    qNode_t *iNode;
+    size_t count = (size_t)0;
+
+    if( ( NULL != destination ) && ( destination != source ) && qList_IsMember( source, first ) && qList_IsMember( source, last ) ){
+        if( ( NULL == after ) || qList_IsMember( destination, after ) ){
+            for( iNode = (qNode_t*)first ; NULL != iNode ; iNode = iNode->next ){ /*count the nodes and check that <last> follows <first>*/
+                iNode->container = destination;
+                count++;
+                if( (qNode_t*)last == iNode ){
+                    RetValue = qTrue;
+                    break;
+                }
+            }
+            if( qTrue == RetValue ){
+                qList_UnlinkRange( source, first, last, count );
+                qList_LinkRange( destination, first, last, after, count );
+            }
+            else{
+                qList_SetRangeContainer( first, NULL, source ); /*<last> precedes <first>, undo the walk*/
+            }
+        }
     }
-    return qFalse;
+    return RetValue;
+}
+/*=========================================================*/
+/*qBool_t qList_SplitAt( qList_t *const list, void * const node, qList_t *const newlist )
+
+Splits the list pointed by <list> in two. The <node> and all the nodes that
+follow it are moved to the back of the list pointed by <newlist>. This is a
+qList_SpliceRange of the second part, so it takes O(k) time, where k is the 
+number of nodes moved to <newlist>.
+
+Parameters:
+
+    - list : Pointer to the list to split.
+    - node : The first node of the second part.
+    - newlist : Pointer to the list that receives the second part.
+
+Return value:
+
+    qTrue if the split operation is performed successfully, otherwise 
+    returns qFalse   
+*/
+qBool_t qList_SplitAt( qList_t *const list, void * const node, qList_t *const newlist ){
+    qBool_t RetValue = qFalse;
+    if( NULL != list ){
+        RetValue = qList_SpliceRange( newlist, ( NULL != newlist )? newlist->tail : NULL, list, node, list->tail );
+    }
+    return RetValue;
 }
 /*=========================================================*/
 /*qBool_t qList_IsMember( qList_t * const list,  void * const node)
@@ -420,9 +562,11 @@ size_t qList_Length( const qList_t * const list ){
 
 Sort the double linked list using the <CompareFcn> function to 
 determine the order.
-The sorting algorithm used by this function compares pairs of 
-adjacent nodes by calling the specified <CompareFcn> function 
-with pointers to them as arguments. The sort is performed only 
+The sorting algorithm used by this function is a bottom-up merge
+sort: sorted runs of 1, 2, 4, ... nodes are merged pairwise until 
+a single run remains, so it takes O(n log n) comparisons. The sort 
+is stable (nodes that compare equal keep their relative order), 
+it does not require any extra memory and is performed only 
 modifying node's links without data swapping, improving performance 
 if nodes have a large storage.
 
@@ -449,48 +593,100 @@ Return value:
 */
 qBool_t qList_Sort( qList_t * const list, qBool_t (*CompareFcn)(const void *n1, const void *n2) ) {
     qBool_t RetValue = qFalse;
-    qBool_t xRetCmp;
-    size_t count, i, j, n;
-    qNode_t *current = NULL, *before, *after;
+    size_t RunSize, LeftSize, RightSize, Merges;
+    qNode_t *Head, *Tail, *Left, *Right, *Next;
 
     if( ( NULL != list ) && ( NULL != CompareFcn ) ){
-        count = list->size;
-        if( count >= (size_t)2){ /*It is only worth running the algorithm if the list has two or more nodes*/
-            for (i = (size_t)1; i < count; i++) {
-                current = list->head;
-                n = count - i - (size_t)1;
-                for (j = (size_t)0; j <= n; j++) { 
-                    xRetCmp = CompareFcn( current, current->next );
-                    if( qTrue == xRetCmp ) { /*compare adyacent nodes*/
-                        before = current->prev;
-                        after = current->next;
-
-                        if( NULL != before) {
-                            before->next = after;
-                        } 
-                        else {
-                            list->head = after; /* In case before pointer is null, after pointer should be the new head*/
+        if( list->size >= (size_t)2 ){ /*It is only worth running the algorithm if the list has two or more nodes*/
+            Head = list->head;
+            Tail = NULL;
+            RunSize = (size_t)1;
+            do{ /*every pass merges pairs of sorted runs of length <RunSize>*/
+                Left = Head;
+                Head = NULL;
+                Tail = NULL;
+                Merges = (size_t)0;
+                while( NULL != Left ){
+                    Merges++;
+                    Right = Left;
+                    for( LeftSize = (size_t)0 ; ( LeftSize < RunSize ) && ( NULL != Right ) ; LeftSize++ ){
+                        Right = Right->next; /*step <RunSize> nodes to find the beginning of the right run*/
+                    }
+                    RightSize = RunSize;
+                    while( ( LeftSize > (size_t)0 ) || ( ( RightSize > (size_t)0 ) && ( NULL != Right ) ) ){
+                        if( (size_t)0 == LeftSize ){
+                            Next = Right;
+                            Right = Right->next;
+                            RightSize--;
                         }
-                        current->next = after->next;
-                        current->prev = after;
-
-                        if( NULL != after->next ) {
-                            after->next->prev = current; /* prev pointer of after->next should be set to current. */
+                        else if( ( (size_t)0 == RightSize ) || ( NULL == Right ) ){
+                            Next = Left;
+                            Left = Left->next;
+                            LeftSize--;
                         }
-
-                        after->next = current;
-                        after->prev = before;
-                        RetValue = qTrue;
-                    } 
-                    else{
-                        current = current->next; /* Go to next node only if current->data > current->next->data condition is false. */
+                        else if( qTrue == CompareFcn( Left, Right ) ){ /*take from the right run only if strictly required to keep it stable*/
+                            Next = Right;
+                            Right = Right->next;
+                            RightSize--;
+                            RetValue = qTrue;
+                        }
+                        else{
+                            Next = Left;
+                            Left = Left->next;
+                            LeftSize--;
+                        }
+                        if( NULL == Tail ){
+                            Head = Next;
+                        }
+                        else{
+                            Tail->next = Next;
+                        }
+                        Next->prev = Tail; /*the backward links are rebuilt on every pass*/
+                        Tail = Next;
                     }
+                    Left = Right;
                 }
+                Tail->next = NULL;
+                RunSize <<= 1;
+            }while( Merges > (size_t)1 );
+            list->head = Head;
+            list->tail = Tail;
+        }
+    }
+    return RetValue;
+}
+/*=========================================================*/
+/*qBool_t qList_InsertSorted( qList_t * const list, void * const node, qBool_t (*CompareFcn)(const void *n1, const void *n2) )
+
+Insert an item into a sorted list keeping the order defined by <CompareFcn>.
+The new node is placed after the nodes that compare equal to it, so the 
+insertion order is preserved among them (FIFO). The list is scanned from the 
+back, so appending in order takes O(1).
+
+Parameters:
+
+    - list : Pointer to the list.
+    - node : A pointer to the node to be inserted
+    - CompareFcn :  Pointer to a function that compares two nodes 
+                    (see qList_Sort). A <qTrue> value indicates that element
+                    pointed by <node1> goes after the element pointed to 
+                    by <node2>
+
+Return value:
+
+    qTrue if the item was successfully added to the list, othewise returns qFalse   
+*/
+qBool_t qList_InsertSorted( qList_t * const list, void * const node, qBool_t (*CompareFcn)(const void *n1, const void *n2) ){
+    qBool_t RetValue = qFalse;
+    qNode_t *iNode;
+
+    if( ( NULL != list ) && ( NULL != node ) && ( NULL != CompareFcn ) ){
+        if( qFalse == qList_IsMember( list, node ) ){
+            for( iNode = list->tail ; ( NULL != iNode ) && ( qTrue == CompareFcn( iNode, node ) ) ; iNode = iNode->prev ){
+                /*skip the nodes that go after the new one*/
             }
-            while( NULL != current->next){ /*loop remaining nodes until find the new tail*/
-                current = current->next;
-            }
-            list->tail = current;            
+            qList_LinkAfter( list, qList_NodeInit( node ), iNode );
+            RetValue = qTrue;
         }
     }
     return RetValue;
@@ -660,13 +856,13 @@ void qList_SetMemoryAllocation( qListMemAllocator_t mallocFcn, qListMemFree_t fr
 qBool_t qList_DInsert( qList_t *const list, void *data, size_t size, qListPosition_t position ){
     qBool_t RetValue = qFalse;
     void *NewNode;
-    if( ( NULL != qListMalloc ) && ( NULL != qListFree ) && ( size > (size_t)0) ){
-        NewNode = qListMalloc( size );
+    if( qList_DynamicEnabled( list ) && ( size > (size_t)0) ){
+        NewNode = qList_NodeAlloc( list, size );
         if( NULL != NewNode ){
             (void)memcpy( NewNode, data, size );
             RetValue = qList_Insert( list, NewNode, position );
             if( qFalse == RetValue ){
-                qListFree( NewNode );
+                qList_NodeFree( NewNode );
             }
         }
     }
@@ -675,10 +871,10 @@ qBool_t qList_DInsert( qList_t *const list, void *data, size_t size, qListPositi
 /*=========================================================*/
 void* qList_DRemove( qList_t * const list, void * const node, const qListPosition_t position ){
     void *removed = NULL;
-    if( ( NULL != qListMalloc ) && ( NULL != qListFree ) ){
+    if( qList_DynamicEnabled( list ) ){
         removed = qList_Remove( list, node, position );
         if( NULL != removed ){
-            qListFree( removed );        
+            qList_NodeFree( removed );        
         }    
     }
     return removed;
@@ -686,12 +882,592 @@ void* qList_DRemove( qList_t * const list, void * const node, const qListPositio
 /*=========================================================*/
 qBool_t qList_DRemoveItself( void * const node ){
     qBool_t RetValue = qFalse;
-    if( ( NULL != qListMalloc ) && ( NULL != qListFree ) ){
-        if( qList_RemoveItself( node ) ){
+    qList_t *list;
+    if( NULL != node ){
+        list = (qList_t*)( (qNode_t*)node )->container;
+        if( qList_DynamicEnabled( list ) ){
+            if( qList_RemoveItself( node ) ){
+                qList_NodeFree( node );
+                RetValue = qTrue;
+            }
+        }
+    }
+    return RetValue;
+}
+/*=========================================================*/
+static qBool_t qList_DynamicEnabled( const qList_t * const list ){
+    qBool_t RetValue = ( ( NULL != qListMalloc ) && ( NULL != qListFree ) )? qTrue : qFalse;
+    #if ( Q_LIST_POOLS == 1 )
+        if( ( NULL != list ) && ( NULL != list->pool ) ){
+            RetValue = qTrue;
+        }
+    #else
+        (void)list;
+    #endif
+    return RetValue;
+}
+/*=========================================================*/
+static void* qList_NodeAlloc( const qList_t * const list, const size_t size ){
+    void *RetValue = NULL;
+    #if ( Q_LIST_POOLS == 1 )
+        qListBlockHeader_t *Header;
+
+        if( ( NULL != list ) && ( NULL != list->pool ) ){
+            if( size <= list->pool->qPrivate.BlockSize ){
+                RetValue = qListPool_Alloc( list->pool );
+            }
+        }
+        else if( NULL != qListMalloc ){ /*heap nodes also carry the header, so any dynamic node knows where to go back*/
+            Header = (qListBlockHeader_t*)qListMalloc( QLIST_HEADER_SIZE + size );
+            if( NULL != Header ){
+                Header->Owner = NULL;
+                Header->Free = qFalse;
+                RetValue = (void*)( (qListAddress_t)Header + QLIST_HEADER_SIZE );
+            }
+        }
+        else{
+            /*dynamic nodes are not available*/
+        }
+    #else
+        (void)list;
+        if( NULL != qListMalloc ){
+            RetValue = qListMalloc( size );
+        }
+    #endif
+    return RetValue;
+}
+/*=========================================================*/
+static void qList_NodeFree( void * const node ){
+    #if ( Q_LIST_POOLS == 1 )
+        qListBlockHeader_t *Header = QLIST_BLOCK_HEADER( node );
+
+        if( NULL != Header->Owner ){ /*the node goes back to the pool it was taken from, whatever list holds it now*/
+            (void)qListPool_Free( Header->Owner, node );
+        }
+        else if( NULL != qListFree ){
+            qListFree( (void*)Header );
+        }
+        else{
+            /*nothing to do*/
+        }
+    #else
+        if( NULL != qListFree ){
             qListFree( node );
+        }
+    #endif
+}
+/*=========================================================*/
+#if ( Q_LIST_POOLS == 1 )
+/*=========================================================*/
+static void qListPool_AddChunk( qListPool_t * const pool, void *Area, size_t AreaSize ){
+    qListAddress_t Address, Limit, Stride;
+    qListBlockHeader_t *Header;
+    void **Block;
+
+    Address = QLIST_POOL_ALIGN( (qListAddress_t)Area );
+    Limit = (qListAddress_t)Area + AreaSize;
+    Stride = QLIST_HEADER_SIZE + pool->qPrivate.BlockSize; /*every block is preceded by a header with its owner*/
+    while( ( Limit > Address ) && ( ( Limit - Address ) >= Stride ) ){ /*carve the blocks and push them to the free list*/
+        Header = (qListBlockHeader_t*)Address;
+        Header->Owner = pool;
+        Header->Free = qTrue;
+        Block = (void**)( Address + QLIST_HEADER_SIZE );
+        *Block = pool->qPrivate.FreeList;
+        pool->qPrivate.FreeList = (void*)Block;
+        Address += Stride;
+        pool->qPrivate.Capacity++;
+    }
+}
+/*=========================================================*/
+/*qBool_t qListPool_Setup( qListPool_t * const pool, size_t BlockSize, void *Area, size_t AreaSize )
+
+Setup a pool of fixed-size blocks. The blocks are taken from <Area> and 
+handed out in constant time using a free list. Every block is preceded by a
+small header that records the owner pool, so a block is given back in 
+constant time to the pool it was taken from.
+
+Parameters:
+
+    - pool : A pointer to the pool object.
+    - BlockSize : The size of each block. To be used with qList_DInsert, it
+                  must be able to hold the largest inserted node.
+    - Area : The memory area that provides the initial blocks (can be NULL
+             if the pool will only grow from an arena).
+    - AreaSize : The size of <Area> in bytes. Each block takes <BlockSize>
+                 plus the header, both aligned to Q_BYTE_ALIGNMENT.
+
+Return value:
+
+    qTrue on success, otherwise returns qFalse.
+*/
+qBool_t qListPool_Setup( qListPool_t * const pool, size_t BlockSize, void *Area, size_t AreaSize ){
+    qBool_t RetValue = qFalse;
+    if( ( NULL != pool ) && ( BlockSize > (size_t)0 ) ){
+        pool->qPrivate.FreeList = NULL;
+        pool->qPrivate.Allocator = NULL;
+        pool->qPrivate.GrowCount = (size_t)0;
+        pool->qPrivate.BlockSize = QLIST_POOL_ALIGN( ( BlockSize < sizeof(void*) )? sizeof(void*) : BlockSize );
+        pool->qPrivate.Capacity = (size_t)0;
+        pool->qPrivate.Used = (size_t)0;
+        pool->qPrivate.HighWater = (size_t)0;
+        if( NULL != Area ){
+            qListPool_AddChunk( pool, Area, AreaSize );
+        }
+        RetValue = qTrue;
+    }
+    return RetValue;
+}
+/*=========================================================*/
+/*void qListPool_SetArena( qListPool_t * const pool, qListMemAllocator_t Allocator, size_t GrowCount )
+
+Set the backing arena of the pool. When the pool runs out of blocks,
+a new chunk able to hold <GrowCount> blocks is requested to <Allocator>. The
+chunks are never returned to the arena.
+
+Parameters:
+
+    - pool : A pointer to the pool object.
+    - Allocator : The arena allocation function (i.e qMalloc). Pass NULL
+                  to disable the growth.
+    - GrowCount : The number of blocks added on every growth.
+*/
+void qListPool_SetArena( qListPool_t * const pool, qListMemAllocator_t Allocator, size_t GrowCount ){
+    if( NULL != pool ){
+        pool->qPrivate.Allocator = Allocator;
+        pool->qPrivate.GrowCount = GrowCount;
+    }
+}
+/*=========================================================*/
+/*void* qListPool_Alloc( qListPool_t * const pool )
+
+Take a block from the pool.
+
+Parameters:
+
+    - pool : A pointer to the pool object.
+
+Return value:
+
+    A pointer to the block. NULL if the pool is exhausted and it can't grow.
+*/
+void* qListPool_Alloc( qListPool_t * const pool ){
+    void *RetValue = NULL;
+    size_t ChunkSize;
+    void *Chunk;
+
+    if( NULL != pool ){
+        if( ( NULL == pool->qPrivate.FreeList ) && ( NULL != pool->qPrivate.Allocator ) && ( pool->qPrivate.GrowCount > (size_t)0 ) ){
+            ChunkSize = ( pool->qPrivate.GrowCount*( QLIST_HEADER_SIZE + pool->qPrivate.BlockSize ) ) + (size_t)Q_BYTE_ALIGNMENT;
+            Chunk = pool->qPrivate.Allocator( ChunkSize );
+            if( NULL != Chunk ){
+                qListPool_AddChunk( pool, Chunk, ChunkSize );
+            }
+        }
+        if( NULL != pool->qPrivate.FreeList ){
+            RetValue = pool->qPrivate.FreeList;
+            pool->qPrivate.FreeList = *( (void**)RetValue );
+            QLIST_BLOCK_HEADER( RetValue )->Free = qFalse;
+            pool->qPrivate.Used++;
+            if( pool->qPrivate.Used > pool->qPrivate.HighWater ){
+                pool->qPrivate.HighWater = pool->qPrivate.Used;
+            }
+        }
+    }
+    return RetValue;
+}
+/*=========================================================*/
+/*qBool_t qListPool_Free( qListPool_t * const pool, void * const block )
+
+Give back a block to the pool. The owner and the state of the block are read
+from the block header, so this takes constant time.
+
+Parameters:
+
+    - pool : A pointer to the pool object.
+    - block : A pointer to a block obtained with qListPool_Alloc.
+
+Return value:
+
+    qTrue on success. qFalse if the block belongs to another pool or if it is
+    already free (a double free).
+*/
+qBool_t qListPool_Free( qListPool_t * const pool, void * const block ){
+    qBool_t RetValue = qFalse;
+    qListBlockHeader_t *Header;
+    if( ( NULL != pool ) && ( NULL != block ) ){
+        Header = QLIST_BLOCK_HEADER( block );
+        if( ( pool == Header->Owner ) && ( qFalse == Header->Free ) ){
+            Header->Free = qTrue;
+            *( (void**)block ) = pool->qPrivate.FreeList;
+            pool->qPrivate.FreeList = block;
+            pool->qPrivate.Used--;
+            RetValue = qTrue;
+        }
+    }
+    return RetValue;
+}
+/*=========================================================*/
+/*size_t qListPool_Capacity( const qListPool_t * const pool )
+
+Returns the total number of blocks of the pool.
+*/
+size_t qListPool_Capacity( const qListPool_t * const pool ){
+    return ( NULL != pool )? pool->qPrivate.Capacity : (size_t)0;
+}
+/*=========================================================*/
+/*size_t qListPool_Used( const qListPool_t * const pool )
+
+Returns the number of blocks currently in use (occupancy).
+*/
+size_t qListPool_Used( const qListPool_t * const pool ){
+    return ( NULL != pool )? pool->qPrivate.Used : (size_t)0;
+}
+/*=========================================================*/
+/*size_t qListPool_HighWater( const qListPool_t * const pool )
+
+Returns the max number of blocks that were in use at the same time.
+*/
+size_t qListPool_HighWater( const qListPool_t * const pool ){
+    return ( NULL != pool )? pool->qPrivate.HighWater : (size_t)0;
+}
+/*=========================================================*/
+/*qBool_t qList_AttachPool( qList_t * const list, qListPool_t * const pool )
+
+Attach a pool to the list. From now on, qList_DInsert takes the nodes of 
+this list from the pool and qList_DRemove/qList_DRemoveItself give them 
+back. The pool can be shared by several lists.
+
+Note: Every dynamic node records where it was taken from, so a node moved
+      to another list (i.e. with qList_Move or qList_SpliceRange) is always
+      given back to its own pool, or to the qList_SetMemoryAllocation 
+      functions if it was taken from the heap.
+
+Parameters:
+
+    - list : Pointer to the list.
+    - pool : A pointer to the pool object. Pass NULL to detach the pool.
+
+Return value:
+
+    qTrue on success, otherwise returns qFalse.
+*/
+qBool_t qList_AttachPool( qList_t * const list, qListPool_t * const pool ){
+    qBool_t RetValue = qFalse;
+    if( NULL != list ){
+        list->pool = pool;
+        RetValue = qTrue;
+    }
+    return RetValue;
+}
+/*=========================================================*/
+#endif /* #if ( Q_LIST_POOLS == 1 ) */
+#if ( Q_LIST_INDEX_LEVELS > 0 )
+
+static qListIndexNode_t* qListIndex_Next( const qListIndex_t * const index, const qListIndexNode_t * const x, const qUINT8_t level );
+static size_t qListIndex_Width( const qListIndexNode_t * const x, const qUINT8_t level );
+static qUINT8_t qListIndex_RandomLevel( qListIndex_t * const index );
+static void qListIndex_Build( qListIndex_t * const index );
+static void qListIndex_FindByRank( const qListIndex_t * const index, const size_t rank, qListIndexNode_t **update );
+static void qListIndex_Unlink( qListIndex_t * const index, qListIndexNode_t **update, qListIndexNode_t * const node );
+
+/*=========================================================*/
+static qListIndexNode_t* qListIndex_Next( const qListIndex_t * const index, const qListIndexNode_t * const x, const qUINT8_t level ){
+    qListIndexNode_t *RetValue;
+    if( level > 0u ){
+        RetValue = (qListIndexNode_t*)x->__qIndexForward[ level - 1u ];
+    }
+    else{ /*the bottom level is the list itself*/
+        RetValue = ( &index->qPrivate.Header == x )? (qListIndexNode_t*)index->qPrivate.List->head : (qListIndexNode_t*)x->next;
+    }
+    return RetValue;
+}
+/*=========================================================*/
+static size_t qListIndex_Width( const qListIndexNode_t * const x, const qUINT8_t level ){
+    return ( level > 0u )? x->__qIndexWidth[ level - 1u ] : (size_t)1;
+}
+/*=========================================================*/
+static qUINT8_t qListIndex_RandomLevel( qListIndex_t * const index ){
+    qUINT32_t r = index->qPrivate.Seed;
+    qUINT8_t Level = 0u;
+    r ^= r << 13; /*xorshift32*/
+    r ^= r >> 17;
+    r ^= r << 5;
+    index->qPrivate.Seed = r;
+    while( ( Level < (qUINT8_t)Q_LIST_INDEX_LEVELS ) && ( 0uL == ( r & 3uL ) ) ){ /*promote with p=1/4*/
+        Level++;
+        r >>= 2;
+    }
+    return Level;
+}
+/*=========================================================*/
+static void qListIndex_Build( qListIndex_t * const index ){
+    qListIndexNode_t *Last[ Q_LIST_INDEX_LEVELS ];
+    size_t LastRank[ Q_LIST_INDEX_LEVELS ];
+    size_t Rank = 0u;
+    qNode_t *iNode;
+    qUINT8_t l, h;
+
+    for( l = 0u ; l < (qUINT8_t)Q_LIST_INDEX_LEVELS ; l++ ){
+        Last[ l ] = &index->qPrivate.Header;
+        LastRank[ l ] = 0u;
+    }
+    index->qPrivate.Height = 0u;
+    for( iNode = index->qPrivate.List->head ; NULL != iNode ; iNode = iNode->next ){
+        Rank++;
+        h = qListIndex_RandomLevel( index );
+        if( h > index->qPrivate.Height ){
+            index->qPrivate.Height = h;
+        }
+        for( l = 0u ; l < h ; l++ ){
+            Last[ l ]->__qIndexForward[ l ] = iNode;
+            Last[ l ]->__qIndexWidth[ l ] = Rank - LastRank[ l ];
+            Last[ l ] = (qListIndexNode_t*)iNode;
+            LastRank[ l ] = Rank;
+        }
+    }
+    for( l = 0u ; l < (qUINT8_t)Q_LIST_INDEX_LEVELS ; l++ ){ /*the last link of every level spans up to the end*/
+        Last[ l ]->__qIndexForward[ l ] = NULL;
+        Last[ l ]->__qIndexWidth[ l ] = Rank + 1u - LastRank[ l ];
+    }
+}
+/*=========================================================*/
+static void qListIndex_FindByRank( const qListIndex_t * const index, const size_t rank, qListIndexNode_t **update ){
+    qListIndexNode_t *x = (qListIndexNode_t*)&index->qPrivate.Header;
+    qListIndexNode_t *xNext;
+    size_t r = 0u;
+    qUINT8_t l;
+
+    for( l = (qUINT8_t)Q_LIST_INDEX_LEVELS ; l > index->qPrivate.Height ; l-- ){ /*the unused levels only hold the header*/
+        update[ l ] = x;
+    }
+    for( ;; ){ /*collect the last node before <rank> on every level in use*/
+        for( xNext = qListIndex_Next( index, x, l ) ; ( NULL != xNext ) && ( ( r + qListIndex_Width( x, l ) ) < rank ) ; xNext = qListIndex_Next( index, x, l ) ){
+            r += qListIndex_Width( x, l );
+            x = xNext;
+        }
+        update[ l ] = x;
+        if( 0u == l ){
+            break;
+        }
+        l--;
+    }
+}
+/*=========================================================*/
+static void qListIndex_Unlink( qListIndex_t * const index, qListIndexNode_t **update, qListIndexNode_t * const node ){
+    qUINT8_t l;
+
+    for( l = 1u ; l <= (qUINT8_t)Q_LIST_INDEX_LEVELS ; l++ ){
+        if( node == update[ l ]->__qIndexForward[ l - 1u ] ){
+            update[ l ]->__qIndexWidth[ l - 1u ] += node->__qIndexWidth[ l - 1u ] - 1u;
+            update[ l ]->__qIndexForward[ l - 1u ] = node->__qIndexForward[ l - 1u ];
+        }
+        else{
+            update[ l ]->__qIndexWidth[ l - 1u ]--;
+        }
+    }
+    (void)qList_RemoveItself( node );
+    while( ( index->qPrivate.Height > 0u ) && ( NULL == index->qPrivate.Header.__qIndexForward[ index->qPrivate.Height - 1u ] ) ){
+        index->qPrivate.Height--;
+    }
+}
+/*=========================================================*/
+/*qBool_t qListIndex_Setup( qListIndex_t * const index, qList_t * const list, qBool_t (*CompareFcn)(const void *n1, const void *n2) )
+
+Attach a skip-list index to the list. The index keeps the list sorted 
+according to <CompareFcn> and provides ordered insertion, positional access
+and removal in O(log n) expected time. If the list has nodes, they are 
+sorted and indexed. All the nodes must start with qListIndex_NodeFields.
+
+Parameters:
+
+    - index : Pointer to the index object.
+    - list : Pointer to the list.
+    - CompareFcn :  Pointer to a function that compares two nodes 
+                    (see qList_Sort).
+
+Return value:
+
+    qTrue on success, otherwise returns qFalse.
+*/
+qBool_t qListIndex_Setup( qListIndex_t * const index, qList_t * const list, qBool_t (*CompareFcn)(const void *n1, const void *n2) ){
+    qBool_t RetValue = qFalse;
+
+    if( ( NULL != index ) && ( NULL != list ) && ( NULL != CompareFcn ) ){
+        index->qPrivate.List = list;
+        index->qPrivate.CompareFcn = CompareFcn;
+        index->qPrivate.Seed = 0x2545F491uL;
+        (void)qList_Sort( list, CompareFcn );
+        qListIndex_Build( index );
+        RetValue = qTrue;
+    }
+    return RetValue;
+}
+/*=========================================================*/
+/*qBool_t qListIndex_Insert( qListIndex_t * const index, void * const node )
+
+Insert a node into the indexed list keeping the order. The new node is
+placed after the nodes that compare equal to it.
+
+Parameters:
+
+    - index : Pointer to the index object.
+    - node : A pointer to the node to be inserted
+
+Return value:
+
+    qTrue if the item was successfully added to the list, othewise returns qFalse   
+*/
+qBool_t qListIndex_Insert( qListIndex_t * const index, void * const node ){
+    qBool_t RetValue = qFalse;
+    qListIndexNode_t *update[ Q_LIST_INDEX_LEVELS + 1 ];
+    size_t Rank[ Q_LIST_INDEX_LEVELS + 1 ];
+    qListIndexNode_t *x, *xNext, *NewNode;
+    qListCompareFcn_t CompareFcn;
+    size_t r = 0u;
+    qUINT8_t l, h;
+
+    if( ( NULL != index ) && ( NULL != node ) ){
+        if( qFalse == qList_IsMember( index->qPrivate.List, node ) ){
+            CompareFcn = index->qPrivate.CompareFcn;
+            x = &index->qPrivate.Header;
+            for( l = (qUINT8_t)Q_LIST_INDEX_LEVELS ; l > index->qPrivate.Height ; l-- ){ /*the unused levels only hold the header*/
+                update[ l ] = x;
+                Rank[ l ] = 0u;
+            }
+            for( ;; ){ /*find the last node that does not go after the new one on every level in use*/
+                for( xNext = qListIndex_Next( index, x, l ) ; ( NULL != xNext ) && ( qFalse == CompareFcn( xNext, node ) ) ; xNext = qListIndex_Next( index, x, l ) ){
+                    r += qListIndex_Width( x, l );
+                    x = xNext;
+                }
+                update[ l ] = x;
+                Rank[ l ] = r;
+                if( 0u == l ){
+                    break;
+                }
+                l--;
+            }
+            NewNode = (qListIndexNode_t*)qList_NodeInit( node );
+            qList_LinkAfter( index->qPrivate.List, (qNode_t*)NewNode, ( &index->qPrivate.Header == update[ 0 ] )? NULL : (qNode_t*)update[ 0 ] );
+            h = qListIndex_RandomLevel( index );
+            if( h > index->qPrivate.Height ){
+                index->qPrivate.Height = h;
+            }
+            for( l = 1u ; l <= (qUINT8_t)Q_LIST_INDEX_LEVELS ; l++ ){
+                if( l <= h ){
+                    NewNode->__qIndexForward[ l - 1u ] = update[ l ]->__qIndexForward[ l - 1u ];
+                    NewNode->__qIndexWidth[ l - 1u ] = update[ l ]->__qIndexWidth[ l - 1u ] - ( Rank[ 0 ] - Rank[ l ] );
+                    update[ l ]->__qIndexForward[ l - 1u ] = NewNode;
+                    update[ l ]->__qIndexWidth[ l - 1u ] = Rank[ 0 ] - Rank[ l ] + 1u;
+                }
+                else{
+                    update[ l ]->__qIndexWidth[ l - 1u ]++; /*the link now spans over the new node*/
+                }
+            }
             RetValue = qTrue;
         }
     }
     return RetValue;
 }
-/*=========================================================*/
\ No newline at end of file
+/*=========================================================*/
+/*void* qListIndex_GetAt( const qListIndex_t * const index, const size_t position )
+
+Get the node located at the given position of the indexed list.
+
+Parameters:
+
+    - index : Pointer to the index object.
+    - position : The zero-based position of the node
+
+Return value:
+
+    A pointer to the node. NULL if the position is out of range.
+*/
+void* qListIndex_GetAt( const qListIndex_t * const index, const size_t position ){
+    qListIndexNode_t *update[ Q_LIST_INDEX_LEVELS + 1 ];
+    void *RetValue = NULL;
+
+    if( NULL != index ){
+        if( position < index->qPrivate.List->size ){
+            qListIndex_FindByRank( index, position + 1u, update );
+            RetValue = qListIndex_Next( index, update[ 0 ], 0u );
+        }
+    }
+    return RetValue;
+}
+/*=========================================================*/
+/*void* qListIndex_RemoveAt( qListIndex_t * const index, const size_t position )
+
+Remove the node located at the given position of the indexed list.
+
+Parameters:
+
+    - index : Pointer to the index object.
+    - position : The zero-based position of the node
+
+Return value:
+
+    A pointer to the removed node. NULL if removal can't be performed.  
+*/
+void* qListIndex_RemoveAt( qListIndex_t * const index, const size_t position ){
+    qListIndexNode_t *update[ Q_LIST_INDEX_LEVELS + 1 ];
+    qListIndexNode_t *removed = NULL;
+
+    if( NULL != index ){
+        if( position < index->qPrivate.List->size ){
+            qListIndex_FindByRank( index, position + 1u, update );
+            removed = qListIndex_Next( index, update[ 0 ], 0u );
+            qListIndex_Unlink( index, update, removed );
+        }
+    }
+    return removed;
+}
+/*=========================================================*/
+/*qBool_t qListIndex_Remove( qListIndex_t * const index, void * const node )
+
+Remove a node from the indexed list.
+
+Parameters:
+
+    - index : Pointer to the index object.
+    - node : A pointer to the node
+
+Return value:
+
+    qTrue on Success. qFalse if removal can't be performed.  
+*/
+qBool_t qListIndex_Remove( qListIndex_t * const index, void * const node ){
+    qBool_t RetValue = qFalse;
+    qListIndexNode_t *update[ Q_LIST_INDEX_LEVELS + 1 ];
+    qListIndexNode_t *x, *xNext;
+    qListCompareFcn_t CompareFcn;
+    size_t r = 0u;
+    qUINT8_t l;
+
+    if( ( NULL != index ) && ( NULL != node ) ){
+        if( qList_IsMember( index->qPrivate.List, node ) ){
+            CompareFcn = index->qPrivate.CompareFcn;
+            x = &index->qPrivate.Header;
+            l = index->qPrivate.Height; /*the levels above are empty*/
+            for( ;; ){ /*find the last node that goes strictly before <node>*/
+                for( xNext = qListIndex_Next( index, x, l ) ; ( NULL != xNext ) && ( qTrue == CompareFcn( node, xNext ) ) ; xNext = qListIndex_Next( index, x, l ) ){
+                    r += qListIndex_Width( x, l );
+                    x = xNext;
+                }
+                if( 0u == l ){
+                    break;
+                }
+                l--;
+            }
+            do{ /*walk through the nodes that compare equal to get the rank of <node>*/
+                x = qListIndex_Next( index, x, 0u );
+                r++;
+            }while( (void*)x != node );
+            qListIndex_FindByRank( index, r, update );
+            qListIndex_Unlink( index, update, x );
+            RetValue = qTrue;
+        }
+    }
+    return RetValue;
+}
+/*=========================================================*/
+#endif /* #if ( Q_LIST_INDEX_LEVELS > 0 ) */
@@ -0,0 +1,184 @@
+#include "qmailbox.h"
+
+static qBool_t qMailbox_ReadItem( const qMailbox_t * const obj, const size_t Sequence, void *dest );
+
+/*============================================================================*/
+/*qBool_t qMailbox_Create( qMailbox_t * const obj, size_t *DataArea, size_t ItemSize, size_t Depth )
+
+Create and configures a mailbox. The RAM used to hold the data <DataArea> is 
+statically allocated by the application writer.
+
+Parameters:
+
+    - obj : A pointer to the mailbox object
+    - DataArea : Data block of qMailbox_AreaWords( ItemSize, Depth ) words.
+    - ItemSize : The size of one item
+    - Depth : The number of latest items kept by the mailbox (1 to keep only
+              the newest one). Must be a power of two.
+
+Return value:
+
+    qTrue on success, otherwise returns qFalse.
+*/
+qBool_t qMailbox_Create( qMailbox_t * const obj, size_t *DataArea, size_t ItemSize, size_t Depth ){
+    qBool_t RetValue = qFalse;
+    size_t i;
+
+    if( ( NULL != obj ) && ( NULL != DataArea ) && ( ItemSize > 0u ) && ( Depth > 0u ) && ( 0u == ( Depth & ( Depth - 1u ) ) ) ){
+        obj->qPrivate.Storage = (qUINT8_t*)DataArea;
+        obj->qPrivate.ItemSize = ItemSize;
+        obj->qPrivate.SlotSize = qMailbox_SlotSize( ItemSize );
+        obj->qPrivate.Mask = Depth - 1u;
+        for( i = 0u ; i < ( Depth*obj->qPrivate.SlotSize )/sizeof(size_t) ; i += obj->qPrivate.SlotSize/sizeof(size_t) ){
+            DataArea[ i ] = 0u; /*the slot doesn't hold any item*/
+        }
+        obj->qPrivate.Posted = 0u;
+        obj->qPrivate.Empty = qTrue;
+        qCritical_MemoryBarrier();
+        RetValue = qTrue;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qBool_t qMailbox_Post( qMailbox_t * const obj, const void *Item )
+
+Post an item to the mailbox, overwriting the oldest one. The item is copied 
+to the mailbox. Only one writer is allowed, several writers must serialize 
+the calls to this function.
+
+Parameters:
+
+    - obj : A pointer to the mailbox object
+    - Item : A pointer to the item to post
+
+Return value:
+
+    qTrue on success, otherwise returns qFalse.
+*/
+qBool_t qMailbox_Post( qMailbox_t * const obj, const void *Item ){
+    qBool_t RetValue = qFalse;
+    volatile size_t *Lock;
+    size_t Sequence;
+
+    if( ( NULL != obj ) && ( NULL != Item ) ){
+        Sequence = obj->qPrivate.Posted + 1u;
+        Lock = (volatile size_t*)( (void*)&obj->qPrivate.Storage[ ( ( Sequence - 1u ) & obj->qPrivate.Mask )*obj->qPrivate.SlotSize ] ); /*the same slot the readers look at, also across the wrap-around*/
+        *Lock = ( 2u*Sequence ) - 1u; /*odd: the slot is being written*/
+        qCritical_MemoryBarrier();
+        (void)memcpy( (void*)&Lock[ 1 ], Item, obj->qPrivate.ItemSize ); /*MISRAC2012-Rule-11.8 allowed*/
+        qCritical_MemoryBarrier();
+        *Lock = 2u*Sequence; /*even: the slot holds the item with this sequence*/
+        qCritical_MemoryBarrier();
+        obj->qPrivate.Posted = Sequence;
+        qCritical_MemoryBarrier();
+        obj->qPrivate.Empty = qFalse;
+        RetValue = qTrue;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*size_t qMailbox_Sequence( const qMailbox_t * const obj )
+
+Returns the sequence of the latest posted item (the number of posts). A zero
+value means that nothing has been posted yet, or that the sequence has just 
+wrapped around.
+*/
+size_t qMailbox_Sequence( const qMailbox_t * const obj ){
+    size_t RetValue = 0u;
+
+    if( NULL != obj ){
+        RetValue = obj->qPrivate.Posted;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*Copy the item with the given sequence. Fails if the slot does not hold that 
+item, or if it was overwritten while being copied.*/
+static qBool_t qMailbox_ReadItem( const qMailbox_t * const obj, const size_t Sequence, void *dest ){
+    volatile size_t *Lock;
+    size_t Before;
+    qBool_t RetValue = qFalse;
+
+    Lock = (volatile size_t*)( (void*)&obj->qPrivate.Storage[ ( ( Sequence - 1u ) & obj->qPrivate.Mask )*obj->qPrivate.SlotSize ] );
+    Before = *Lock;
+    qCritical_MemoryBarrier();
+    if( ( 2u*Sequence ) == Before ){
+        (void)memcpy( dest, (const void*)&Lock[ 1 ], obj->qPrivate.ItemSize ); /*MISRAC2012-Rule-11.8 allowed*/
+        qCritical_MemoryBarrier();
+        RetValue = ( Before == *Lock )? qTrue : qFalse;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qBool_t qMailbox_ReadLatest( const qMailbox_t * const obj, void *dest, size_t * const Sequence )
+
+Read the newest item in the mailbox, without removing it.
+
+Parameters:
+
+    - obj : A pointer to the mailbox object
+    - dest : Pointer to the buffer into which the item will be copied.
+    - Sequence : Optional. Receives the sequence of the item read. Comparing 
+                 it against the sequence of a previous read gives the number 
+                 of updates in between. Can be NULL.
+
+Return value:
+
+    qTrue if an item was read, qFalse if nothing has been posted yet.
+*/
+qBool_t qMailbox_ReadLatest( const qMailbox_t * const obj, void *dest, size_t * const Sequence ){
+    qBool_t RetValue = qFalse;
+    size_t Latest;
+
+    if( ( NULL != obj ) && ( NULL != dest ) && ( qFalse == obj->qPrivate.Empty ) ){
+        qCritical_MemoryBarrier();
+        do{
+            Latest = obj->qPrivate.Posted;
+            qCritical_MemoryBarrier();
+        }while( qFalse == qMailbox_ReadItem( obj, Latest, dest ) ); /*retry with a newer item if the writer overwrote it*/
+        if( NULL != Sequence ){
+            *Sequence = Latest;
+        }
+        RetValue = qTrue;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qBool_t qMailbox_ReadNext( const qMailbox_t * const obj, void *dest, size_t * const Cursor )
+
+Read the item that follows the last one read by this reader, without removing
+it. Each reader keeps its own <Cursor>. If the writer has overwritten the 
+following item, the oldest item still kept is read instead, so the items 
+missed by the reader are given by the jump of the cursor minus one.
+
+Parameters:
+
+    - obj : A pointer to the mailbox object
+    - dest : Pointer to the buffer into which the item will be copied.
+    - Cursor : The sequence of the last item read by this reader (initialize 
+               it to zero). It is updated with the sequence of the item read.
+
+Return value:
+
+    qTrue if an item was read, qFalse if there are no new items for this 
+    reader.
+*/
+qBool_t qMailbox_ReadNext( const qMailbox_t * const obj, void *dest, size_t * const Cursor ){
+    qBool_t RetValue = qFalse;
+    size_t Latest, Ahead, Next;
+
+    if( ( NULL != obj ) && ( NULL != dest ) && ( NULL != Cursor ) ){
+        do{
+            Latest = obj->qPrivate.Posted;
+            qCritical_MemoryBarrier();
+            Ahead = Latest - *Cursor;
+            Next = ( Ahead > obj->qPrivate.Mask )? ( Latest - obj->qPrivate.Mask ) : ( *Cursor + 1u ); /*skip the overwritten items*/
+        }while( ( 0u != Ahead ) && ( qFalse == qMailbox_ReadItem( obj, Next, dest ) ) );
+        if( 0u != Ahead ){
+            *Cursor = Next;
+            RetValue = qTrue;
+        }
+    }
+    return RetValue;
+}
+/*============================================================================*/
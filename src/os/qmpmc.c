@@ -0,0 +1,205 @@
+#include "qmpmc.h"
+
+static volatile size_t* qMPMC_Sequence( const qMPMC_t * const obj, const size_t pos );
+static size_t qMPMC_Claim( qMPMC_t * const obj, volatile size_t * const index, const size_t ahead, size_t n, size_t * const first );
+
+/*============================================================================*/
+static volatile size_t* qMPMC_Sequence( const qMPMC_t * const obj, const size_t pos ){
+    return (volatile size_t*)( (void*)&obj->qPrivate.Storage[ ( pos & obj->qPrivate.Mask )*obj->qPrivate.SlotSize ] );
+}
+/*============================================================================*/
+/*
+Claim up to <n> consecutive tickets from <index>. A ticket <pos> is available
+when the sequence of its slot is equal to <pos> + <ahead> (0 for the producers,
+1 for the consumers). Returns the number of claimed tickets and the first one 
+in <first>.
+*/
+static size_t qMPMC_Claim( qMPMC_t * const obj, volatile size_t * const index, const size_t ahead, size_t n, size_t * const first ){
+    size_t Pos, Seq, Ready = 0u;
+    qBool_t Retry;
+
+    do{
+        Retry = qFalse;
+        Pos = *index;
+        for( Ready = 0u ; Ready < n ; Ready++ ){
+            Seq = *qMPMC_Sequence( obj, Pos + Ready );
+            qCritical_MemoryBarrier(); /*read the sequence before the slot*/
+            if( Seq != ( Pos + Ready + ahead ) ){
+                if( ( 0u == Ready ) && ( (ptrdiff_t)( Seq - ( Pos + ahead ) ) > 0 ) ){
+                    Retry = qTrue; /*another thread took this ticket, reload the index*/
+                }
+                break;
+            }
+        }
+        if( Ready > 0u ){
+            if( qFalse == qCritical_CompareAndSwapSize( index, Pos, Pos + Ready ) ){
+                Retry = qTrue;
+            }
+        }
+    }while( qTrue == Retry );
+    *first = Pos;
+    return Ready;
+}
+/*============================================================================*/
+/*qBool_t qMPMC_Create( qMPMC_t * const obj, size_t *DataArea, size_t ItemSize, size_t ItemsCount )
+
+Create and configures a multi-producer/multi-consumer ring. The RAM used to 
+hold the data <DataArea> is statically allocated by the application writer.
+
+Parameters:
+
+    - obj : A pointer to the ring object
+    - DataArea : Data block of qMPMC_AreaWords( ItemSize, ItemsCount ) words.
+    - ItemSize : The size of one item
+    - ItemsCount : The max number of items the ring can hold. Must be a 
+                   power of two.
+
+Return value:
+
+    qTrue on success, otherwise returns qFalse.
+*/
+qBool_t qMPMC_Create( qMPMC_t * const obj, size_t *DataArea, size_t ItemSize, size_t ItemsCount ){
+    qBool_t RetValue = qFalse;
+    size_t i;
+
+    if( ( NULL != obj ) && ( NULL != DataArea ) && ( ItemSize > 0u ) && ( ItemsCount > 0u ) && ( 0u == ( ItemsCount & ( ItemsCount - 1u ) ) ) ){
+        obj->qPrivate.Storage = (qUINT8_t*)DataArea;
+        obj->qPrivate.ItemSize = ItemSize;
+        obj->qPrivate.SlotSize = qMPMC_SlotSize( ItemSize );
+        obj->qPrivate.Mask = ItemsCount - 1u;
+        for( i = 0u ; i < ItemsCount ; i++ ){
+            *qMPMC_Sequence( obj, i ) = i; /*every slot is free for the ticket with its own index*/
+        }
+        obj->qPrivate.EnqueuePos = 0u;
+        obj->qPrivate.DequeuePos = 0u;
+        qCritical_MemoryBarrier();
+        RetValue = qTrue;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*size_t qMPMC_SendN( qMPMC_t * const obj, const void *Items, size_t n )
+
+Post up to <n> consecutive items to the ring without blocking. The slots for
+all the items are claimed with a single compare-and-swap.
+
+Parameters:
+
+    - obj : A pointer to the ring object
+    - Items : A pointer to the items to send
+    - n : The number of items to send
+
+Return value:
+
+    The number of items actually sent.
+*/
+size_t qMPMC_SendN( qMPMC_t * const obj, const void *Items, size_t n ){
+    size_t Pos, i;
+    const qUINT8_t *Src = (const qUINT8_t*)Items;
+    volatile size_t *Seq;
+
+    if( ( NULL != obj ) && ( NULL != Items ) && ( n > 0u ) ){
+        n = qMPMC_Claim( obj, &obj->qPrivate.EnqueuePos, 0u, n, &Pos );
+        for( i = 0u ; i < n ; i++ ){
+            Seq = qMPMC_Sequence( obj, Pos + i );
+            (void)memcpy( (void*)&Seq[ 1 ], &Src[ i*obj->qPrivate.ItemSize ], obj->qPrivate.ItemSize ); /*MISRAC2012-Rule-11.8 allowed*/
+            qCritical_MemoryBarrier(); /*publish the item before the sequence*/
+            *Seq = Pos + i + 1u;
+        }
+    }
+    else{
+        n = 0u;
+    }
+    return n;
+}
+/*============================================================================*/
+/*size_t qMPMC_ReceiveN( qMPMC_t * const obj, void *dest, size_t n )
+
+Receive up to <n> consecutive items from the ring without blocking. The slots
+of all the items are claimed with a single compare-and-swap.
+
+Parameters:
+
+    - obj : A pointer to the ring object
+    - dest : Pointer to the buffer into which the received items will be copied.
+    - n : The max number of items to receive
+
+Return value:
+
+    The number of items actually received.
+*/
+size_t qMPMC_ReceiveN( qMPMC_t * const obj, void *dest, size_t n ){
+    size_t Pos, i;
+    qUINT8_t *Dst = (qUINT8_t*)dest;
+    volatile size_t *Seq;
+
+    if( ( NULL != obj ) && ( NULL != dest ) && ( n > 0u ) ){
+        n = qMPMC_Claim( obj, &obj->qPrivate.DequeuePos, 1u, n, &Pos );
+        for( i = 0u ; i < n ; i++ ){
+            Seq = qMPMC_Sequence( obj, Pos + i );
+            (void)memcpy( &Dst[ i*obj->qPrivate.ItemSize ], (const void*)&Seq[ 1 ], obj->qPrivate.ItemSize ); /*MISRAC2012-Rule-11.8 allowed*/
+            qCritical_MemoryBarrier(); /*finish the copy before releasing the slot*/
+            *Seq = Pos + i + obj->qPrivate.Mask + 1u; /*free for the ticket of the next lap*/
+        }
+    }
+    else{
+        n = 0u;
+    }
+    return n;
+}
+/*============================================================================*/
+/*qBool_t qMPMC_TrySend( qMPMC_t * const obj, const void *ItemToSend )
+
+Post an item to the ring without blocking.
+
+Parameters:
+
+    - obj : A pointer to the ring object
+    - ItemToSend : A pointer to the item
+
+Return value:
+
+    qTrue on successful add, qFalse if the ring is full.
+*/
+qBool_t qMPMC_TrySend( qMPMC_t * const obj, const void *ItemToSend ){
+    return ( 1u == qMPMC_SendN( obj, ItemToSend, 1u ) )? qTrue : qFalse;
+}
+/*============================================================================*/
+/*qBool_t qMPMC_TryReceive( qMPMC_t * const obj, void *dest )
+
+Receive an item from the ring without blocking.
+
+Parameters:
+
+    - obj : A pointer to the ring object
+    - dest : Pointer to the buffer into which the received item will be copied.
+
+Return value:
+
+    qTrue if an item was received, qFalse if the ring is empty.
+*/
+qBool_t qMPMC_TryReceive( qMPMC_t * const obj, void *dest ){
+    return ( 1u == qMPMC_ReceiveN( obj, dest, 1u ) )? qTrue : qFalse;
+}
+/*============================================================================*/
+/*size_t qMPMC_Count( const qMPMC_t * const obj )
+
+Returns the approximate number of items in the ring (it can change at any
+time due to the activity of the other threads).
+*/
+size_t qMPMC_Count( const qMPMC_t * const obj ){
+    size_t RetValue = 0u;
+    size_t Enqueued, Dequeued;
+
+    if( NULL != obj ){
+        Dequeued = obj->qPrivate.DequeuePos;
+        Enqueued = obj->qPrivate.EnqueuePos;
+        RetValue = Enqueued - Dequeued;
+        if( (ptrdiff_t)RetValue < 0 ){ /*the consumers moved after the read*/
+            RetValue = 0u;
+        }
+        RetValue = ( RetValue > ( obj->qPrivate.Mask + 1u ) )? ( obj->qPrivate.Mask + 1u ) : RetValue;
+    }
+    return RetValue;
+}
+/*============================================================================*/
@@ -0,0 +1,140 @@
+#include "qmpsc.h"
+
+static qNode_t* qMPSC_Take( qMPSC_t * const obj );
+
+/*============================================================================*/
+static qNode_t* qMPSC_Take( qMPSC_t * const obj ){
+    void *Head;
+    do{
+        Head = obj->qPrivate.Head;
+    }while( ( NULL != Head ) && ( qFalse == qCritical_CompareAndSwap( &obj->qPrivate.Head, Head, NULL ) ) );
+    return (qNode_t*)Head;
+}
+/*============================================================================*/
+/*qBool_t qMPSC_Initialize( qMPSC_t * const obj )
+
+Initialize the object as empty. Must be called before any producer uses it.
+
+Parameters:
+
+    - obj : A pointer to the MPSC object
+
+Return value:
+
+    qTrue on success, otherwise returns qFalse.
+*/
+qBool_t qMPSC_Initialize( qMPSC_t * const obj ){
+    qBool_t RetValue = qFalse;
+    if( NULL != obj ){
+        obj->qPrivate.Head = NULL;
+        RetValue = qTrue;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qBool_t qMPSC_Push( qMPSC_t * const obj, void * const node )
+
+Push a node. Can be called from any execution context, including ISRs and
+other threads, concurrently with other producers and with the consumer.
+
+Parameters:
+
+    - obj : A pointer to the MPSC object
+    - node : A pointer to the node. The node must not belong to a list and 
+             it is owned by the consumer from now on.
+
+Return value:
+
+    qTrue on success, otherwise returns qFalse. The push fails if the node
+    belongs to a list or if it is still pending in a handoff.
+*/
+qBool_t qMPSC_Push( qMPSC_t * const obj, void * const node ){
+    qBool_t RetValue = qFalse;
+    qNode_t *xNode = (qNode_t*)node;
+    void *Head;
+
+    if( ( NULL != obj ) && ( NULL != xNode ) ){
+        if( qTrue == qCritical_CompareAndSwap( (void * volatile *)&xNode->container, NULL, obj ) ){ /*mark the node as pending, a second push fails here*/
+            xNode->prev = NULL;
+            do{
+                Head = obj->qPrivate.Head;
+                xNode->next = (qNode_t*)Head;
+            }while( qFalse == qCritical_CompareAndSwap( &obj->qPrivate.Head, Head, xNode ) ); /*retry if another producer got there first*/
+            RetValue = qTrue;
+        }
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qBool_t qMPSC_IsEmpty( const qMPSC_t * const obj )
+
+Returns qTrue if there are no pushed nodes, otherwise returns qFalse.
+*/
+qBool_t qMPSC_IsEmpty( const qMPSC_t * const obj ){
+    return ( ( NULL == obj ) || ( NULL == obj->qPrivate.Head ) )? qTrue : qFalse;
+}
+/*============================================================================*/
+/*void* qMPSC_PopAll( qMPSC_t * const obj )
+
+Take all the pushed nodes in one step. The nodes are returned as a 
+NULL-terminated chain in the push order, linked through their <next> and
+<prev> fields (see qList_NodeNext). 
+Only the consumer is allowed to call this function.
+
+Parameters:
+
+    - obj : A pointer to the MPSC object
+
+Return value:
+
+    A pointer to the first pushed node, or NULL if there was nothing pushed.
+*/
+void* qMPSC_PopAll( qMPSC_t * const obj ){
+    qNode_t *First = NULL;
+    qNode_t *iNode, *Next;
+
+    if( NULL != obj ){
+        for( iNode = qMPSC_Take( obj ) ; NULL != iNode ; iNode = Next ){ /*reverse the stack into the push order*/
+            Next = iNode->next;
+            iNode->next = First;
+            iNode->prev = NULL;
+            iNode->container = NULL; /*no longer pending, can be pushed again*/
+            if( NULL != First ){
+                First->prev = iNode;
+            }
+            First = iNode;
+        }
+    }
+    return First;
+}
+/*============================================================================*/
+/*size_t qMPSC_PopAllToList( qMPSC_t * const obj, qList_t * const list )
+
+Take all the pushed nodes in one step and append them to the back of 
+<list> in the push order.
+Only the consumer is allowed to call this function.
+
+Parameters:
+
+    - obj : A pointer to the MPSC object
+    - list : Pointer to the destination list
+
+Return value:
+
+    The number of nodes moved to the list.
+*/
+size_t qMPSC_PopAllToList( qMPSC_t * const obj, qList_t * const list ){
+    size_t RetValue = 0u;
+    qNode_t *iNode, *Next;
+
+    if( NULL != list ){
+        for( iNode = (qNode_t*)qMPSC_PopAll( obj ) ; NULL != iNode ; iNode = Next ){
+            Next = iNode->next;
+            if( qList_Insert( list, iNode, qList_AtBack ) ){
+                RetValue++;
+            }
+        }
+    }
+    return RetValue;
+}
+/*============================================================================*/
@@ -0,0 +1,378 @@
+#include "qpqueues.h"
+
+#if (Q_QUEUES == 1)
+
+static qBool_t qPQueueGoesBefore( const qPQueueEntry_t * const e1, const qPQueueEntry_t * const e2 );
+static void qPQueueSiftUp( const qPQueue_t * const obj, size_t i );
+static void qPQueueSiftDown( const qPQueue_t * const obj, size_t i );
+static size_t qPQueuePop( qPQueue_t * const obj );
+static void qPQueueFreeSlot( qPQueue_t * const obj, const size_t Index );
+
+/*============================================================================*/
+/*qBool_t qPQueueCreate( qPQueue_t * const obj, void *DataArea, qPQueueEntry_t *Entries, size_t ItemSize, size_t ItemsCount )
+
+Create and configures a priority message queue. The RAM used to hold the items 
+<DataArea> and the heap <Entries> is statically allocated by the application 
+writer.
+
+Parameters:
+
+    - obj : a pointer to the priority queue object
+    - DataArea : data block to hold <ItemsCount> items of <ItemSize> bytes.
+    - Entries : an array of <ItemsCount> entries.
+    - ItemSize : size of one item
+    - ItemsCount : the max number of items the queue can hold
+
+Return value:
+
+    qTrue on success, otherwise returns qFalse.
+*/
+qBool_t qPQueueCreate( qPQueue_t * const obj, void *DataArea, qPQueueEntry_t *Entries, size_t ItemSize, size_t ItemsCount ){
+    qBool_t RetValue = qFalse;
+
+    if( ( NULL != obj ) && ( NULL != DataArea ) && ( NULL != Entries ) && ( ItemSize > 0u ) && ( ItemsCount > 0u ) ){
+        obj->qPrivate.Storage = (qUINT8_t*)DataArea;
+        obj->qPrivate.Entries = Entries;
+        obj->qPrivate.ItemSize = ItemSize;
+        obj->qPrivate.ItemsCount = ItemsCount;
+        qPQueueReset( obj );
+        RetValue = qTrue;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*void qPQueueReset( qPQueue_t * const obj )
+
+Resets a priority queue to its original empty state.
+
+Parameters:
+
+    - obj : a pointer to the priority queue object
+*/
+void qPQueueReset( qPQueue_t * const obj ){
+    size_t i;
+
+    if( NULL != obj ){
+        qCritical_Enter();
+        for( i = 0u ; i < obj->qPrivate.ItemsCount ; i++ ){
+            obj->qPrivate.Entries[ i ].Slot = i; /*every slot is free*/
+        }
+        obj->qPrivate.Count = 0u;
+        obj->qPrivate.Free = obj->qPrivate.ItemsCount;
+        obj->qPrivate.Stamp = 0uL;
+        qCritical_Exit();
+    }
+}
+/*============================================================================*/
+static qBool_t qPQueueGoesBefore( const qPQueueEntry_t * const e1, const qPQueueEntry_t * const e2 ){
+    qBool_t RetValue = qFalse;
+
+    if( e1->Priority > e2->Priority ){
+        RetValue = qTrue;
+    }
+    else if( e1->Priority == e2->Priority ){
+        RetValue = ( (qINT32_t)( e1->Stamp - e2->Stamp ) < 0 )? qTrue : qFalse; /*the older goes first, survives the wrap-around of the stamps*/
+    }
+    else{
+        /*nothing to do*/
+    }
+    return RetValue;
+}
+/*============================================================================*/
+static void qPQueueSiftUp( const qPQueue_t * const obj, size_t i ){
+    qPQueueEntry_t *Heap = obj->qPrivate.Entries;
+    qPQueueEntry_t Moving = Heap[ i ];
+    size_t Parent;
+
+    while( i > 0u ){
+        Parent = ( i - 1u ) >> 1u;
+        if( qFalse == qPQueueGoesBefore( &Moving, &Heap[ Parent ] ) ){
+            break;
+        }
+        Heap[ i ] = Heap[ Parent ];
+        i = Parent;
+    }
+    Heap[ i ] = Moving;
+}
+/*============================================================================*/
+static void qPQueueSiftDown( const qPQueue_t * const obj, size_t i ){
+    qPQueueEntry_t *Heap = obj->qPrivate.Entries;
+    qPQueueEntry_t Moving = Heap[ i ];
+    size_t Child, Count = obj->qPrivate.Count;
+
+    for( Child = ( i << 1u ) + 1u ; Child < Count ; Child = ( i << 1u ) + 1u ){
+        if( ( ( Child + 1u ) < Count ) && ( qTrue == qPQueueGoesBefore( &Heap[ Child + 1u ], &Heap[ Child ] ) ) ){
+            Child++; /*take the child that goes first*/
+        }
+        if( qFalse == qPQueueGoesBefore( &Heap[ Child ], &Moving ) ){
+            break;
+        }
+        Heap[ i ] = Heap[ Child ];
+        i = Child;
+    }
+    Heap[ i ] = Moving;
+}
+/*============================================================================*/
+/*remove the entry at the top of the heap and return its slot. The slot is 
+held right after the heap, at the Count index, until it is freed*/
+static size_t qPQueuePop( qPQueue_t * const obj ){
+    size_t Slot = obj->qPrivate.Entries[ 0 ].Slot;
+
+    obj->qPrivate.Count--;
+    if( obj->qPrivate.Count > 0u ){
+        obj->qPrivate.Entries[ 0 ] = obj->qPrivate.Entries[ obj->qPrivate.Count ];
+        qPQueueSiftDown( obj, 0u );
+    }
+    obj->qPrivate.Entries[ obj->qPrivate.Count ].Slot = Slot;
+    return Slot;
+}
+/*============================================================================*/
+/*the held slots are kept between the heap and the free slots at the end of the
+entries array. Free the held slot at <Index> by swapping it with the last held one*/
+static void qPQueueFreeSlot( qPQueue_t * const obj, const size_t Index ){
+    qPQueueEntry_t *Entries = obj->qPrivate.Entries;
+    size_t Last = obj->qPrivate.ItemsCount - obj->qPrivate.Free - 1u;
+    size_t Slot = Entries[ Index ].Slot;
+
+    Entries[ Index ].Slot = Entries[ Last ].Slot;
+    Entries[ Last ].Slot = Slot;
+    obj->qPrivate.Free++;
+}
+/*============================================================================*/
+/*qBool_t qPQueueSend( qPQueue_t * const obj, const void *ItemToQueue, const qPriority_t Priority )
+
+Post an item to the priority queue. The item is queued by copy, not by 
+reference, and it will be received after the items with a higher priority and
+after the items with the same priority that were sent before.
+
+Parameters:
+
+    - obj : a pointer to the priority queue object
+    - ItemToQueue : A pointer to the item that is to be placed on the queue.
+    - Priority : The priority of the item. Higher values are received first.
+
+Return value:
+
+    qTrue on successful add, qFalse if not added (the queue is full).
+*/
+qBool_t qPQueueSend( qPQueue_t * const obj, const void *ItemToQueue, const qPriority_t Priority ){
+    qBool_t RetValue = qFalse;
+    qPQueueEntry_t *Entry;
+    size_t Slot, Free;
+
+    if( ( NULL != obj ) && ( NULL != ItemToQueue ) ){
+        qCritical_Enter();
+        if( obj->qPrivate.Free > 0u ){
+            Free = obj->qPrivate.ItemsCount - obj->qPrivate.Free;
+            Slot = obj->qPrivate.Entries[ Free ].Slot; /*take a free slot*/
+            obj->qPrivate.Free--;
+            obj->qPrivate.Entries[ Free ].Slot = obj->qPrivate.Entries[ obj->qPrivate.Count ].Slot; /*the heap grows over the first held slot (if any), so move it to the end of the held ones*/
+            (void)memcpy( (void*)&obj->qPrivate.Storage[ Slot*obj->qPrivate.ItemSize ], ItemToQueue, obj->qPrivate.ItemSize );
+            Entry = &obj->qPrivate.Entries[ obj->qPrivate.Count ];
+            Entry->Slot = Slot;
+            Entry->Priority = Priority;
+            Entry->Stamp = obj->qPrivate.Stamp++;
+            obj->qPrivate.Count++;
+            qPQueueSiftUp( obj, obj->qPrivate.Count - 1u );
+            RetValue = qTrue;
+        }
+        qCritical_Exit();
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qBool_t qPQueueReceive( qPQueue_t * const obj, void *dest, qPriority_t * const Priority )
+
+Receive the item with the highest priority (and removes it). The item is 
+received by copy so a buffer of adequate size must be provided.
+
+Parameters:
+
+    - obj : a pointer to the priority queue object
+    - dest : Pointer to the buffer into which the received item will be copied.
+    - Priority : Optional. Receives the priority of the item. Can be NULL.
+
+Return value:
+
+    qTrue if data was retrieved from the queue, otherwise returns qFalse
+*/
+qBool_t qPQueueReceive( qPQueue_t * const obj, void *dest, qPriority_t * const Priority ){
+    qBool_t RetValue = qFalse;
+    size_t Slot;
+
+    if( ( NULL != obj ) && ( NULL != dest ) ){
+        qCritical_Enter();
+        if( obj->qPrivate.Count > 0u ){
+            if( NULL != Priority ){
+                *Priority = obj->qPrivate.Entries[ 0 ].Priority;
+            }
+            Slot = qPQueuePop( obj );
+            (void)memcpy( dest, (void*)&obj->qPrivate.Storage[ Slot*obj->qPrivate.ItemSize ], obj->qPrivate.ItemSize );
+            qPQueueFreeSlot( obj, obj->qPrivate.Count );
+            RetValue = qTrue;
+        }
+        qCritical_Exit();
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*void* qPQueuePeek( const qPQueue_t * const obj )
+
+Looks at the item with the highest priority without removing it.
+
+Parameters:
+
+    - obj : a pointer to the priority queue object
+
+Return value:
+
+    Pointer to the data, or NULL if there is nothing in the queue
+*/
+void* qPQueuePeek( const qPQueue_t * const obj ){
+    qUINT8_t *RetValue = NULL;
+
+    if( NULL != obj ){
+        qCritical_Enter();
+        if( obj->qPrivate.Count > 0u ){
+            RetValue = &obj->qPrivate.Storage[ obj->qPrivate.Entries[ 0 ].Slot*obj->qPrivate.ItemSize ];
+        }
+        qCritical_Exit();
+    }
+    return (void*)RetValue;
+}
+/*============================================================================*/
+/*qBool_t qPQueueRemoveFront( qPQueue_t * const obj )
+
+Remove the item with the highest priority.
+
+Parameters:
+
+    - obj : a pointer to the priority queue object
+
+Return value:
+
+    qTrue if data was removed from the queue, otherwise returns qFalse
+*/
+qBool_t qPQueueRemoveFront( qPQueue_t * const obj ){
+    qBool_t RetValue = qFalse;
+
+    if( NULL != obj ){
+        qCritical_Enter();
+        if( obj->qPrivate.Count > 0u ){
+            (void)qPQueuePop( obj );
+            qPQueueFreeSlot( obj, obj->qPrivate.Count );
+            RetValue = qTrue;
+        }
+        qCritical_Exit();
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*void* qPQueueReceiveSlot( qPQueue_t * const obj )
+
+Remove the item with the highest priority from the queue order, but keep its 
+slot, so the item can be processed in place. Items sent in the meantime can't 
+take the place of this one. Once done, the slot must be given back with 
+qPQueueRelease.
+
+Parameters:
+
+    - obj : a pointer to the priority queue object
+
+Return value:
+
+    A pointer to the item, or NULL if there is nothing in the queue
+*/
+void* qPQueueReceiveSlot( qPQueue_t * const obj ){
+    qUINT8_t *RetValue = NULL;
+
+    if( NULL != obj ){
+        qCritical_Enter();
+        if( obj->qPrivate.Count > 0u ){
+            RetValue = &obj->qPrivate.Storage[ qPQueuePop( obj )*obj->qPrivate.ItemSize ];
+        }
+        qCritical_Exit();
+    }
+    return (void*)RetValue;
+}
+/*============================================================================*/
+/*qBool_t qPQueueRelease( qPQueue_t * const obj, void * const slot )
+
+Give back a slot obtained with qPQueueReceiveSlot.
+
+Parameters:
+
+    - obj : a pointer to the priority queue object
+    - slot : The pointer returned by qPQueueReceiveSlot.
+
+Return value:
+
+    qTrue on success. qFalse if <slot> is not a slot of the queue that is 
+    being held, so a slot can't be released twice.
+*/
+qBool_t qPQueueRelease( qPQueue_t * const obj, void * const slot ){
+    qBool_t RetValue = qFalse;
+    size_t Offset, Slot, i, End;
+
+    if( ( NULL != obj ) && ( NULL != slot ) ){
+        if( (qUINT8_t*)slot >= obj->qPrivate.Storage ){
+            Offset = (size_t)( (qUINT8_t*)slot - obj->qPrivate.Storage );
+            if( ( Offset < ( obj->qPrivate.ItemsCount*obj->qPrivate.ItemSize ) ) && ( 0u == ( Offset % obj->qPrivate.ItemSize ) ) ){
+                Slot = Offset/obj->qPrivate.ItemSize;
+                qCritical_Enter();
+                End = obj->qPrivate.ItemsCount - obj->qPrivate.Free;
+                for( i = obj->qPrivate.Count ; i < End ; i++ ){ /*look for it among the held slots*/
+                    if( Slot == obj->qPrivate.Entries[ i ].Slot ){
+                        qPQueueFreeSlot( obj, i );
+                        RetValue = qTrue;
+                        break;
+                    }
+                }
+                qCritical_Exit();
+            }
+        }
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*size_t qPQueueCount( const qPQueue_t * const obj )
+
+Returns the number of items in the priority queue.
+*/
+size_t qPQueueCount( const qPQueue_t * const obj ){
+    size_t RetValue = 0u;
+
+    if( NULL != obj ){
+        RetValue = obj->qPrivate.Count;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qBool_t qPQueueIsEmpty( const qPQueue_t * const obj )
+
+Returns qTrue if the priority queue is empty, otherwise returns qFalse.
+*/
+qBool_t qPQueueIsEmpty( const qPQueue_t * const obj ){
+    qBool_t RetValue = qTrue;
+
+    if( NULL != obj ){
+        RetValue = ( 0u == obj->qPrivate.Count )? qTrue : qFalse;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qBool_t qPQueueIsFull( const qPQueue_t * const obj )
+
+Returns qTrue if the priority queue is full, otherwise returns qFalse.
+*/
+qBool_t qPQueueIsFull( const qPQueue_t * const obj ){
+    qBool_t RetValue = qFalse;
+
+    if( NULL != obj ){
+        RetValue = ( 0u == obj->qPrivate.Free )? qTrue : qFalse;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+
+#endif /* #if (Q_QUEUES == 1) */
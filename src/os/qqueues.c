@@ -4,7 +4,29 @@
 
 static void qQueueCopyDataToQueue( qQueue_t * const obj, const void *pvItemToQueue, const qBool_t xPosition );
 static void qQueueMoveReader( qQueue_t * const obj );
+static void* qQueueFrontSlot( const qQueue_t * const obj );
 static void qQueueCopyDataFromQueue( qQueue_t * const obj, void * const pvBuffer );
+static void qQueueCopyItem( const qQueue_t * const obj, void * const dest, const void * const src );
+static void qQueueEnter( const qQueue_t * const obj );
+static void qQueueExit( const qQueue_t * const obj );
+static size_t qQueueWaiting( const qQueue_t * const obj );
+static void qQueueAdded( qQueue_t * const obj, const size_t n );
+static void qQueueRemoved( qQueue_t * const obj, const size_t n );
+#if ( Q_QUEUE_SET_SIZE > 0 )
+    static qUINT8_t qQueueSetLowestBit( const qUINT32_t mask );
+    static void qQueueSetDetach( const qQueue_t * const queue );
+    static qQueueSet_t *SetRegistry = NULL;
+#endif
+#if ( Q_QUEUE_STATS == 1 )
+    static void qQueueStampSlots( const qQueue_t * const obj, const qUINT8_t *slot, size_t n );
+    static void qQueueMeasureSlots( qQueue_t * const obj, const qUINT8_t *slot, size_t n );
+    static qQueue_t *StatsRegistry = NULL;
+    #define qQueueStatsCount( obj, field, n )       ( (obj)->Stats.field += (n) )
+#else
+    #define qQueueStampSlots( obj, slot, n )
+    #define qQueueMeasureSlots( obj, slot, n )
+    #define qQueueStatsCount( obj, field, n )
+#endif
 
 /*============================================================================*/
 /*qBool_t qQueueCreate(qQueue_t * const obj, void* DataBlock, const qSize_t ElementSize, const qSize_t ElementCount)
@@ -22,6 +44,10 @@ Parameters:
 Note: Element_count should be a power of two, or it will only use the next 
       higher power of two
 
+Note: If the queue is a member of a queue set, it is removed from the set.
+      If the queue is in the statistics registry, it is removed from the 
+      registry.
+
     Return value:
 
     qTrue on success, otherwise returns qFalse.
@@ -34,12 +60,115 @@ qBool_t qQueueCreate( qQueue_t * const obj, void* DataArea, size_t ItemSize, siz
         obj->ItemSize = ItemSize;
         obj->pHead = DataArea;
         obj->pTail = obj->pHead + ( obj->ItemsCount * obj->ItemSize ); 
+        obj->LockFree = qFalse;
+        #if ( Q_QUEUE_SET_SIZE > 0 )
+            qQueueSetDetach( obj ); /*the set fields could be uninitialized here, so the membership is taken from the sets*/
+            obj->Set = NULL;
+            obj->SetBit = 0uL;
+        #endif
+        #if ( Q_QUEUE_STATS == 1 )
+            (void)qQueueUnregisterStats( obj ); /*the registry fields could be uninitialized here, so the membership is taken from the registry*/
+            obj->Timestamps = NULL;
+            obj->Name = NULL;
+            qQueueResetStats( obj );
+        #endif
         qQueueReset( obj );
         RetValue = qTrue;
     }
     return RetValue;
 }
 /*============================================================================*/
+/*qBool_t qQueueCreateSPSC( qQueue_t * const obj, void* DataArea, size_t ItemSize, size_t ItemsCount )
+ 
+Create and configures a lock-free Queue for exactly one producer and one 
+consumer, that can run on different execution contexts (i.e. an ISR and a 
+task). The write pointer and the number of items sent are only modified by 
+the producer, and the read pointer and the number of items received only 
+by the consumer, so no critical sections are used. The queue can be attached
+to a task with qTaskAttachQueue, in that case, the task is the consumer.
+
+Note: qQueueSendToFront is not available in this mode, since it modifies 
+      the consumer side. qQueueReset is only safe when both sides are idle.
+ 
+Parameters:
+
+    - obj : a pointer to the Queue object
+    - DataArea :  data block or array of data
+    - ItemSize : size of one element in the data block
+    - ItemsCount : the max number of items the queue can hold
+
+Return value:
+
+    qTrue on success, otherwise returns qFalse.
+*/
+qBool_t qQueueCreateSPSC( qQueue_t * const obj, void* DataArea, size_t ItemSize, size_t ItemsCount ){
+    qBool_t RetValue = qQueueCreate( obj, DataArea, ItemSize, ItemsCount );
+    if( qTrue == RetValue ){
+        obj->LockFree = qTrue;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+static void qQueueEnter( const qQueue_t * const obj ){
+    if( qFalse == obj->LockFree ){
+        qCritical_Enter();
+    }
+}
+/*============================================================================*/
+static void qQueueExit( const qQueue_t * const obj ){
+    if( qFalse == obj->LockFree ){
+        qCritical_Exit();
+    }
+}
+/*============================================================================*/
+static size_t qQueueWaiting( const qQueue_t * const obj ){
+    size_t RetValue;
+    if( qFalse == obj->LockFree ){
+        RetValue = obj->ItemsWaiting;
+    }
+    else{
+        RetValue = obj->ItemsSent - obj->ItemsReceived; /*each counter has a single writer, the unsigned difference survives the wrap-around*/
+        qCritical_MemoryBarrier(); /*read the counters before the slots*/
+    }
+    return RetValue;
+}
+/*============================================================================*/
+static void qQueueAdded( qQueue_t * const obj, const size_t n ){
+    #if ( Q_QUEUE_STATS == 1 )
+        size_t Waiting = qQueueWaiting( obj ) + n;
+        obj->Stats.TotalItems += (qUINT32_t)n;
+        obj->Stats.HighWater = ( Waiting > obj->Stats.HighWater )? Waiting : obj->Stats.HighWater;
+    #endif
+    if( qFalse == obj->LockFree ){
+        obj->ItemsWaiting += n;
+        #if ( Q_QUEUE_SET_SIZE > 0 )
+            if( NULL != obj->Set ){
+                obj->Set->qPrivate.ReadyMask |= obj->SetBit; /*the queue holds items now*/
+            }
+        #endif
+    }
+    else{
+        qCritical_MemoryBarrier(); /*publish the data before the counter*/
+        obj->ItemsSent += n;
+    }
+}
+/*============================================================================*/
+static void qQueueRemoved( qQueue_t * const obj, const size_t n ){
+    obj->HeldSlot = NULL; /*the front item is gone, so it can't be held anymore*/
+    if( qFalse == obj->LockFree ){
+        obj->ItemsWaiting -= n;
+        #if ( Q_QUEUE_SET_SIZE > 0 )
+            if( ( NULL != obj->Set ) && ( 0u == obj->ItemsWaiting ) ){
+                obj->Set->qPrivate.ReadyMask &= ~obj->SetBit; /*the queue was drained*/
+            }
+        #endif
+    }
+    else{
+        qCritical_MemoryBarrier(); /*finish any access to the slots before releasing them*/
+        obj->ItemsReceived += n;
+    }
+}
+/*============================================================================*/
 /*void qQueueReset(qQueue_t * const obj)
  
 Resets a queue to its original empty state.
@@ -52,8 +181,16 @@ void qQueueReset( qQueue_t * const obj ){
     if ( NULL != obj ){
         qCritical_Enter();
         obj->ItemsWaiting = 0u;
+        obj->ItemsSent = 0u;
+        obj->ItemsReceived = 0u;
         obj->pcWriteTo = obj->pHead;
         obj->pcReadFrom = obj->pHead + ( ( obj->ItemsCount - 1u ) * obj->ItemSize );
+        obj->HeldSlot = NULL;
+        #if ( Q_QUEUE_SET_SIZE > 0 )
+            if( NULL != obj->Set ){
+                obj->Set->qPrivate.ReadyMask &= ~obj->SetBit;
+            }
+        #endif
         qCritical_Exit();
     }
 }
@@ -73,7 +210,7 @@ Return value:
 qBool_t qQueueIsEmpty( const qQueue_t * const obj ){
     qBool_t RetValue = qTrue;
     if( NULL != obj ){
-        if( obj->ItemsWaiting == 0u ){
+        if( 0u == qQueueWaiting( obj ) ){
             RetValue = qTrue;
         }
         else{
@@ -98,7 +235,7 @@ Return value:
 size_t qQueueCount( const qQueue_t * const obj ){
     size_t RetValue = 0u;
     if ( NULL != obj ){
-        RetValue = obj->ItemsWaiting;
+        RetValue = qQueueWaiting( obj );
     } 
     return RetValue;
 }
@@ -119,7 +256,7 @@ Return value:
 qBool_t qQueueIsFull( const qQueue_t * const obj ){
     qBool_t RetValue = qFalse;
     if( NULL != obj ){
-        if( obj->ItemsWaiting == obj->ItemsCount ){
+        if( obj->ItemsCount == qQueueWaiting( obj ) ){
             RetValue = qTrue;
         }
     }
@@ -139,15 +276,21 @@ Return value:
     Pointer to the data, or NULL if there is nothing in the queue
  */
 void* qQueuePeek( const qQueue_t * const obj ){
-    qUINT8_t *RetValue = NULL;
+    void *RetValue = NULL;
     if( NULL != obj ){
-        if( obj->ItemsWaiting > 0u ){
-            qCritical_Enter();
-            RetValue = (void*)( obj->pcReadFrom + obj->ItemSize );  /*MISRAC2012-Rule-11.8 allowed*/
-            if( RetValue >= obj->pTail ){
-                RetValue = obj->pHead;
-            }
-            qCritical_Exit();
+        qQueueEnter( obj );
+        RetValue = qQueueFrontSlot( obj );
+        qQueueExit( obj );
+    }
+    return RetValue;
+}
+/*============================================================================*/
+static void* qQueueFrontSlot( const qQueue_t * const obj ){
+    qUINT8_t *RetValue = NULL;
+    if( qQueueWaiting( obj ) > 0u ){
+        RetValue = (qUINT8_t*)( obj->pcReadFrom + obj->ItemSize );  /*MISRAC2012-Rule-11.8 allowed*/
+        if( RetValue >= obj->pTail ){
+            RetValue = obj->pHead;
         }
     }
     return (void*)RetValue;
@@ -168,11 +311,12 @@ Return value:
 qBool_t qQueueRemoveFront( qQueue_t * const obj ){
     qBool_t RetValue = qFalse;
     if( NULL != obj ){
-        if( obj->ItemsWaiting > 0u ){
-            qCritical_Enter();
+        if( qQueueWaiting( obj ) > 0u ){
+            qQueueEnter( obj );
             qQueueMoveReader( obj );
-            --( obj->ItemsWaiting ); /* remove the data. */
-            qCritical_Exit();
+            qQueueMeasureSlots( obj, obj->pcReadFrom, 1u );
+            qQueueRemoved( obj, 1u ); /* remove the data. */
+            qQueueExit( obj );
             RetValue = qTrue;
         }
     }
@@ -181,7 +325,8 @@ qBool_t qQueueRemoveFront( qQueue_t * const obj ){
 /*============================================================================*/
 static void qQueueCopyDataToQueue( qQueue_t * const obj, const void *pvItemToQueue, const qBool_t xPosition ){
     if( QUEUE_SEND_TO_BACK == xPosition ){
-        (void) memcpy( (void*) obj->pcWriteTo, pvItemToQueue, obj->ItemSize );  /*MISRAC2012-Rule-11.8 allowed*/
+        qQueueCopyItem( obj, (void*) obj->pcWriteTo, pvItemToQueue );  /*MISRAC2012-Rule-11.8 allowed*/
+        qQueueStampSlots( obj, obj->pcWriteTo, 1u );
         obj->pcWriteTo += obj->ItemSize;
         if( obj->pcWriteTo >= obj->pTail ){
             obj->pcWriteTo = obj->pHead;
@@ -189,13 +334,14 @@ static void qQueueCopyDataToQueue( qQueue_t * const obj, const void *pvItemToQue
               
     }
     else{
-        (void) memcpy( (void*) obj->pcReadFrom, pvItemToQueue, obj->ItemSize );  /*MISRAC2012-Rule-11.8 allowed*/
+        qQueueCopyItem( obj, (void*) obj->pcReadFrom, pvItemToQueue );  /*MISRAC2012-Rule-11.8 allowed*/
+        qQueueStampSlots( obj, obj->pcReadFrom, 1u );
         obj->pcReadFrom -= obj->ItemSize;
         if( obj->pcReadFrom < obj->pHead ){
             obj->pcReadFrom = ( obj->pTail - obj->ItemSize ); 
         }   
     }
-    ++( obj->ItemsWaiting );
+    qQueueAdded( obj, 1u );
 }
 /*==================================================================================*/
 static void qQueueMoveReader( qQueue_t * const obj ){
@@ -207,7 +353,17 @@ static void qQueueMoveReader( qQueue_t * const obj ){
 /*==================================================================================*/
 static void qQueueCopyDataFromQueue( qQueue_t * const obj, void * const pvBuffer ){
     qQueueMoveReader( obj );
-    (void) memcpy( (void*) pvBuffer, (void*)obj->pcReadFrom, obj->ItemSize );  /*MISRAC2012-Rule-11.8 allowed*/
+    qQueueMeasureSlots( obj, obj->pcReadFrom, 1u );
+    qQueueCopyItem( obj, pvBuffer, (void*)obj->pcReadFrom );  /*MISRAC2012-Rule-11.8 allowed*/
+}
+/*==================================================================================*/
+static void qQueueCopyItem( const qQueue_t * const obj, void * const dest, const void * const src ){
+    if( 1u == obj->ItemSize ){ /*byte queues are the common case, skip the call to memcpy*/
+        *(qUINT8_t*)dest = *(const qUINT8_t*)src;
+    }
+    else{
+        (void) memcpy( dest, src, obj->ItemSize );
+    }
 }
 /*============================================================================*/
 /*void* qQueueReceive(qQueue_t * const obj, void *dest)
@@ -227,11 +383,11 @@ Return value:
 */
 qBool_t qQueueReceive( qQueue_t * const obj, void *dest ){
     qBool_t RetValue = qFalse;
-    if( obj->ItemsWaiting > 0u ){
-        qCritical_Enter();
+    if( qQueueWaiting( obj ) > 0u ){
+        qQueueEnter( obj );
         qQueueCopyDataFromQueue( obj, dest );
-        --( obj->ItemsWaiting ); /* remove the data. */
-        qCritical_Exit();
+        qQueueRemoved( obj, 1u ); /* remove the data. */
+        qQueueExit( obj );
         RetValue = qTrue;
     }
     return RetValue;
@@ -250,7 +406,16 @@ Parameters:
             area.
     - InsertMode : Can take the value QUEUE_SEND_TO_BACK to place the item at the back 
                   of the queue, or QUEUE_SEND_TO_FRONT to place the item at the front of 
-                  the queue (for high priority messages).
+                  the queue (for high priority messages). With QUEUE_OVERWRITE the item
+                  is placed at the back and, if the queue is full, the oldest item
+                  is discarded to make room for it.
+
+Note: While the front slot is held with qQueuePeekSlot (i.e. a task attached
+      as receiver is processing the item in place), the front belongs to the
+      consumer: QUEUE_SEND_TO_FRONT fails, and if the queue is full, 
+      QUEUE_OVERWRITE replaces the newest item instead of the oldest one. If 
+      the held item is the only one in the queue (a queue of length 1), 
+      there is nothing to replace and QUEUE_OVERWRITE fails.
   
 Return value:
 
@@ -258,16 +423,668 @@ Return value:
 */
 qBool_t qQueueGenericSend( qQueue_t * const obj, void *ItemToQueue, qQueueMode_t InsertMode ){
     qBool_t RetValue = qFalse;
-    if( ( NULL != obj ) && ( InsertMode <= 1u ) ){
-        if( obj->ItemsWaiting < obj->ItemsCount ){ /* Is there room on the queue?*/
-            qCritical_Enter();
-            qQueueCopyDataToQueue( obj, ItemToQueue, (qBool_t)InsertMode );
-            qCritical_Exit();
+    qBool_t Overflow = qFalse;
+    qUINT8_t *Newest;
+    if( ( NULL != obj ) && ( InsertMode <= QUEUE_OVERWRITE ) ){
+        qQueueEnter( obj );
+        if( ( qTrue == obj->LockFree ) && ( QUEUE_SEND_TO_BACK != InsertMode ) ){
+            /*not allowed, the front belongs to the consumer*/
+        }
+        else if( ( NULL != obj->HeldSlot ) && ( QUEUE_SEND_TO_FRONT == InsertMode ) ){
+            /*not allowed, the front slot is held by the consumer*/
+        }
+        else if( qQueueWaiting( obj ) < obj->ItemsCount ){ /* Is there room on the queue?*/
+            qQueueCopyDataToQueue( obj, ItemToQueue, (qBool_t)( ( QUEUE_SEND_TO_FRONT == InsertMode )? QUEUE_SEND_TO_FRONT : QUEUE_SEND_TO_BACK ) );
             RetValue = qTrue;
         }
+        else if( ( QUEUE_OVERWRITE == InsertMode ) && ( NULL == obj->HeldSlot ) ){
+            qQueueMoveReader( obj ); /*discard the oldest item*/
+            qQueueRemoved( obj, 1u );
+            qQueueStatsCount( obj, Dropped, 1u );
+            qQueueCopyDataToQueue( obj, ItemToQueue, (qBool_t)QUEUE_SEND_TO_BACK );
+            RetValue = qTrue;
+        }
+        else if( ( QUEUE_OVERWRITE == InsertMode ) && ( obj->ItemsCount > 1u ) ){ /*the oldest item is being processed in place, replace the newest one*/
+            Newest = ( obj->pcWriteTo == obj->pHead )? obj->pTail : obj->pcWriteTo;
+            Newest -= obj->ItemSize;
+            qQueueCopyItem( obj, (void*)Newest, ItemToQueue );
+            qQueueStampSlots( obj, Newest, 1u );
+            qQueueStatsCount( obj, Dropped, 1u );
+            RetValue = qTrue;
+        }
+        else{
+            qQueueStatsCount( obj, SendFailures, 1u );
+            Overflow = qTrue;
+        }
+        qQueueExit( obj );
+        if( qTrue == Overflow ){
+            qHook_QueueOverflow( obj, ItemToQueue );
+        }
     }
     return RetValue;   
 }
 /*============================================================================*/
+/*size_t qQueueSendN( qQueue_t * const obj, const void *Items, size_t n )
+ 
+Post up to <n> consecutive items to the back of the queue. The items are queued 
+by copy using at most two memory copies (before and after the wrap) inside a 
+single critical section.
+ 
+Parameters:
+
+    - obj : a pointer to the Queue object
+    - Items : A pointer to the items that are to be placed on the queue.
+    - n : The number of items to send.
+  
+Return value:
+
+    The number of items actually sent. If not all the items fit in the queue,
+    the overflow hook is invoked with the first item that was not sent.
+*/
+size_t qQueueSendN( qQueue_t * const obj, const void *Items, size_t n ){
+    size_t Requested = n, First, Room;
+    const qUINT8_t *Src = (const qUINT8_t*)Items;
+
+    if( ( NULL != obj ) && ( NULL != Items ) && ( n > 0u ) ){
+        qQueueEnter( obj );
+        Room = obj->ItemsCount - qQueueWaiting( obj );
+        n = ( n > Room )? Room : n;
+        if( n > 0u ){
+            qQueueStampSlots( obj, obj->pcWriteTo, n );
+            First = (size_t)( obj->pTail - obj->pcWriteTo )/obj->ItemSize; /*free slots before the wrap*/
+            First = ( First > n )? n : First;
+            (void)memcpy( (void*)obj->pcWriteTo, Src, First*obj->ItemSize );
+            obj->pcWriteTo += First*obj->ItemSize;
+            if( n > First ){
+                (void)memcpy( (void*)obj->pHead, &Src[ First*obj->ItemSize ], ( n - First )*obj->ItemSize );
+                obj->pcWriteTo = obj->pHead + ( ( n - First )*obj->ItemSize );
+            }
+            if( obj->pcWriteTo >= obj->pTail ){
+                obj->pcWriteTo = obj->pHead;
+            }
+            qQueueAdded( obj, n );
+        }
+        qQueueStatsCount( obj, SendFailures, Requested - n );
+        qQueueExit( obj );
+        if( n < Requested ){
+            qHook_QueueOverflow( obj, (void*)&Src[ n*obj->ItemSize ] );  /*MISRAC2012-Rule-11.8 allowed*/
+        }
+    }
+    else{
+        n = 0u;
+    }
+    return n;
+}
+/*============================================================================*/
+/*size_t qQueueReceiveN( qQueue_t * const obj, void *dest, size_t n )
+ 
+Receive up to <n> items from the front of the queue (and removes them). The items 
+are received by copy using at most two memory copies (before and after the wrap)
+inside a single critical section, so a buffer of adequate size must be provided.
+ 
+Parameters:
+
+    - obj : a pointer to the Queue object
+    - dest: Pointer to the buffer into which the received items will be copied.
+    - n : The max number of items to receive.
+  
+Return value:
+
+    The number of items actually received.
+*/
+size_t qQueueReceiveN( qQueue_t * const obj, void *dest, size_t n ){
+    size_t First, Available;
+    qUINT8_t *Dst = (qUINT8_t*)dest;
+    qUINT8_t *ReadFrom;
+
+    if( ( NULL != obj ) && ( NULL != dest ) && ( n > 0u ) ){
+        qQueueEnter( obj );
+        Available = qQueueWaiting( obj );
+        n = ( n > Available )? Available : n;
+        if( n > 0u ){
+            ReadFrom = obj->pcReadFrom + obj->ItemSize; /*the reader points to the last item read*/
+            if( ReadFrom >= obj->pTail ){
+                ReadFrom = obj->pHead;
+            }
+            qQueueMeasureSlots( obj, ReadFrom, n );
+            First = (size_t)( obj->pTail - ReadFrom )/obj->ItemSize; /*items before the wrap*/
+            First = ( First > n )? n : First;
+            (void)memcpy( (void*)Dst, ReadFrom, First*obj->ItemSize );
+            obj->pcReadFrom = ReadFrom + ( ( First - 1u )*obj->ItemSize );
+            if( n > First ){
+                (void)memcpy( (void*)&Dst[ First*obj->ItemSize ], obj->pHead, ( n - First )*obj->ItemSize );
+                obj->pcReadFrom = obj->pHead + ( ( n - First - 1u )*obj->ItemSize );
+            }
+            qQueueRemoved( obj, n );
+        }
+        qQueueExit( obj );
+    }
+    else{
+        n = 0u;
+    }
+    return n;
+}
+/*============================================================================*/
+/*void* qQueueReserve( qQueue_t * const obj )
+ 
+Get a pointer to the next free slot at the back of the queue, so the item can
+be written in place (i.e. by a DMA transfer) instead of being copied. The item 
+is not visible to the receivers until qQueueCommit is called.
+
+Note: Only one slot can be reserved at a time, and no other send operation 
+      should take place on the queue between the reservation and the commit.
+ 
+Parameters:
+
+    - obj : a pointer to the Queue object
+  
+Return value:
+
+    A pointer to the slot, or NULL if the queue is full.
+*/
+void* qQueueReserve( qQueue_t * const obj ){
+    void *RetValue = NULL;
+    if( NULL != obj ){
+        qQueueEnter( obj );
+        if( qQueueWaiting( obj ) < obj->ItemsCount ){
+            RetValue = (void*)obj->pcWriteTo;
+        }
+        else{
+            qQueueStatsCount( obj, SendFailures, 1u );
+        }
+        qQueueExit( obj );
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qBool_t qQueueCommit( qQueue_t * const obj, void * const slot )
+ 
+Post the item written in a slot obtained with qQueueReserve to the back of 
+the queue.
+ 
+Parameters:
+
+    - obj : a pointer to the Queue object
+    - slot : The pointer returned by qQueueReserve.
+  
+Return value:
+
+    qTrue on success. qFalse if <slot> is not the reserved slot.
+*/
+qBool_t qQueueCommit( qQueue_t * const obj, void * const slot ){
+    qBool_t RetValue = qFalse;
+    if( ( NULL != obj ) && ( NULL != slot ) ){
+        qQueueEnter( obj );
+        if( ( (qUINT8_t*)slot == obj->pcWriteTo ) && ( qQueueWaiting( obj ) < obj->ItemsCount ) ){
+            qQueueStampSlots( obj, obj->pcWriteTo, 1u );
+            obj->pcWriteTo += obj->ItemSize;
+            if( obj->pcWriteTo >= obj->pTail ){
+                obj->pcWriteTo = obj->pHead;
+            }
+            qQueueAdded( obj, 1u );
+            RetValue = qTrue;
+        }
+        qQueueExit( obj );
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*void* qQueuePeekSlot( qQueue_t * const obj )
+ 
+Get a pointer to the slot at the front of the queue, so the item can be
+processed in place. The slot is held until it is given back with 
+qQueueRelease. Meanwhile, the item can't be discarded by an overwrite and 
+no item can be sent to the front. See qQueuePeek.
+ 
+Parameters:
+
+    - obj : a pointer to the Queue object
+  
+Return value:
+
+    A pointer to the front slot. NULL if the queue is empty.
+*/
+void* qQueuePeekSlot( qQueue_t * const obj ){
+    void *RetValue = NULL;
+    if( NULL != obj ){
+        qQueueEnter( obj );
+        RetValue = qQueueFrontSlot( obj );
+        obj->HeldSlot = RetValue;
+        qQueueExit( obj );
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qBool_t qQueueRelease( qQueue_t * const obj, void * const slot )
+ 
+Remove the item at the front of the queue after it was processed in place
+through the pointer returned by qQueuePeekSlot.
+ 
+Parameters:
+
+    - obj : a pointer to the Queue object
+    - slot : The pointer returned by qQueuePeekSlot.
+  
+Return value:
+
+    qTrue on success. If <slot> is not the held slot, or the held item is no
+    longer at the front of the queue, the item is not consumed, the
+    qHook_QueueReleaseMismatch hook is invoked and qFalse is returned.
+*/
+qBool_t qQueueRelease( qQueue_t * const obj, void * const slot ){
+    qBool_t RetValue = qFalse;
+    if( ( NULL != obj ) && ( NULL != slot ) ){
+        qQueueEnter( obj );
+        if( ( slot == obj->HeldSlot ) && ( slot == qQueueFrontSlot( obj ) ) ){
+            qQueueMoveReader( obj );
+            qQueueMeasureSlots( obj, obj->pcReadFrom, 1u );
+            qQueueRemoved( obj, 1u );
+            RetValue = qTrue;
+        }
+        else if( slot == obj->HeldSlot ){
+            obj->HeldSlot = NULL;
+        }
+        else{
+            /*nothing to do, another slot is being held*/
+        }
+        qQueueExit( obj );
+        if( qFalse == RetValue ){
+            qHook_QueueReleaseMismatch( obj, slot );
+        }
+    }
+    return RetValue;
+}
+#if ( Q_QUEUE_STATS == 1 )
+/*============================================================================*/
+static void qQueueStampSlots( const qQueue_t * const obj, const qUINT8_t *slot, size_t n ){
+    size_t Index;
+    qClock_t Now;
+
+    if( NULL != obj->Timestamps ){
+        Now = qClock_GetTick();
+        Index = (size_t)( slot - obj->pHead )/obj->ItemSize;
+        for( ; n > 0u ; n-- ){
+            obj->Timestamps[ Index ] = Now;
+            Index = ( ( Index + 1u ) < obj->ItemsCount )? ( Index + 1u ) : 0u;
+        }
+    }
+}
+/*============================================================================*/
+static void qQueueMeasureSlots( qQueue_t * const obj, const qUINT8_t *slot, size_t n ){
+    size_t Index;
+    qClock_t Now, Latency;
+
+    if( NULL != obj->Timestamps ){
+        Now = qClock_GetTick();
+        Index = (size_t)( slot - obj->pHead )/obj->ItemSize;
+        for( ; n > 0u ; n-- ){
+            Latency = Now - obj->Timestamps[ Index ];
+            obj->Stats.LatencyMax = ( Latency > obj->Stats.LatencyMax )? Latency : obj->Stats.LatencyMax;
+            obj->Stats.LatencySum += Latency;
+            obj->Stats.LatencySamples++;
+            Index = ( ( Index + 1u ) < obj->ItemsCount )? ( Index + 1u ) : 0u;
+        }
+    }
+}
+/*============================================================================*/
+/*qBool_t qQueueRegisterStats( qQueue_t * const obj, const char *Name, qClock_t *Timestamps )
+
+Add a queue to the statistics registry, so its statistics can be reported by
+qQueueForEachStats. Must be called after the queue has been created, creating
+it again removes it from the registry. A queue that goes out of scope must 
+be removed first with qQueueUnregisterStats. The occupancy and failure 
+counters are kept for every queue, the latency is only measured if a 
+<Timestamps> array is supplied.
+
+Parameters:
+
+    - obj : a pointer to the Queue object
+    - Name : The name used to identify the queue in the reports. Can be NULL.
+    - Timestamps : Optional. An array with one qClock_t per item of the queue 
+                   (the ItemsCount of the queue), used to store the send time 
+                   of each item. The latency is the time between the send and
+                   the receive of the item, in epochs. Pass NULL to disable 
+                   the latency measurement.
+
+Return value:
+
+    qTrue on success, otherwise returns qFalse.
+*/
+qBool_t qQueueRegisterStats( qQueue_t * const obj, const char *Name, qClock_t *Timestamps ){
+    qBool_t RetValue = qFalse;
+    qQueue_t *iQueue;
+
+    if( ( NULL != obj ) && ( NULL != obj->pHead ) ){
+        qCritical_Enter();
+        iQueue = StatsRegistry;
+        while( ( NULL != iQueue ) && ( obj != iQueue ) ){
+            iQueue = (qQueue_t*)iQueue->NextRegistered;
+        }
+        if( NULL == iQueue ){ /*not registered yet*/
+            obj->NextRegistered = (void*)StatsRegistry;
+            StatsRegistry = obj;
+        }
+        obj->Name = Name;
+        obj->Timestamps = Timestamps;
+        qCritical_Exit();
+        RetValue = qTrue;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qBool_t qQueueUnregisterStats( const qQueue_t * const obj )
+
+Remove a queue from the statistics registry. Must be called before a 
+registered queue goes out of scope.
+
+Parameters:
+
+    - obj : a pointer to the Queue object
+
+Return value:
+
+    qTrue if the queue was removed, qFalse if it was not registered.
+*/
+qBool_t qQueueUnregisterStats( const qQueue_t * const obj ){
+    qBool_t RetValue = qFalse;
+    qQueue_t *iQueue, *Prev = NULL;
+
+    if( NULL != obj ){
+        qCritical_Enter();
+        iQueue = StatsRegistry;
+        while( ( NULL != iQueue ) && ( obj != iQueue ) ){
+            Prev = iQueue;
+            iQueue = (qQueue_t*)iQueue->NextRegistered;
+        }
+        if( NULL != iQueue ){
+            if( NULL == Prev ){
+                StatsRegistry = (qQueue_t*)iQueue->NextRegistered;
+            }
+            else{
+                Prev->NextRegistered = iQueue->NextRegistered;
+            }
+            iQueue->NextRegistered = NULL;
+            RetValue = qTrue;
+        }
+        qCritical_Exit();
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qBool_t qQueueGetStats( const qQueue_t * const obj, qQueueStats_t * const dest )
+
+Get a consistent copy of the statistics of a queue.
+
+Parameters:
+
+    - obj : a pointer to the Queue object
+    - dest : The location where the statistics will be copied.
+
+Return value:
+
+    qTrue on success, otherwise returns qFalse.
+*/
+qBool_t qQueueGetStats( const qQueue_t * const obj, qQueueStats_t * const dest ){
+    qBool_t RetValue = qFalse;
+
+    if( ( NULL != obj ) && ( NULL != dest ) ){
+        qCritical_Enter();
+        *dest = obj->Stats;
+        qCritical_Exit();
+        RetValue = qTrue;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*void qQueueResetStats( qQueue_t * const obj )
+
+Clear the statistics of a queue.
+
+Parameters:
+
+    - obj : a pointer to the Queue object
+*/
+void qQueueResetStats( qQueue_t * const obj ){
+    if( NULL != obj ){
+        qCritical_Enter();
+        obj->Stats.HighWater = 0u;
+        obj->Stats.SendFailures = 0u;
+        obj->Stats.Dropped = 0u;
+        obj->Stats.TotalItems = 0uL;
+        obj->Stats.LatencyMax = 0uL;
+        obj->Stats.LatencySum = 0uL;
+        obj->Stats.LatencySamples = 0uL;
+        qCritical_Exit();
+    }
+}
+/*============================================================================*/
+/*void qQueueForEachStats( const qQueueStatsFcn_t Fcn, void *arg )
+
+Report the statistics of every registered queue, i.e. to dump them from a 
+diagnostics task. The callback gets a consistent copy of the statistics of 
+each queue, taken right before the call.
+
+Parameters:
+
+    - Fcn : The function called for every registered queue.
+    - arg : An argument passed to <Fcn>.
+*/
+void qQueueForEachStats( const qQueueStatsFcn_t Fcn, void *arg ){
+    qQueue_t *iQueue;
+    qQueueStats_t Snapshot;
+
+    if( NULL != Fcn ){
+        for( iQueue = StatsRegistry ; NULL != iQueue ; iQueue = (qQueue_t*)iQueue->NextRegistered ){
+            (void)qQueueGetStats( iQueue, &Snapshot );
+            Fcn( iQueue, iQueue->Name, &Snapshot, arg );
+        }
+    }
+}
+#endif /* #if ( Q_QUEUE_STATS == 1 ) */
+#if ( Q_QUEUE_SET_SIZE > 0 )
+/*============================================================================*/
+/*qBool_t qQueueSetCreate( qQueueSet_t * const set )
+
+Create and configures an empty queue set. The set is linked to the registry
+of created sets. If the set was already created, its current members are 
+released first.
+
+Parameters:
+
+    - set : a pointer to the queue set object
+
+Return value:
+
+    qTrue on success, otherwise returns qFalse.
+*/
+qBool_t qQueueSetCreate( qQueueSet_t * const set ){
+    qBool_t RetValue = qFalse;
+    qQueueSet_t *iSet;
+    qUINT8_t i;
+
+    if( NULL != set ){
+        qCritical_Enter();
+        iSet = SetRegistry;
+        while( ( NULL != iSet ) && ( set != iSet ) ){
+            iSet = iSet->qPrivate.Next;
+        }
+        if( set == iSet ){ /*created again, the members must not point to it anymore*/
+            for( i = 0u ; i < (qUINT8_t)Q_QUEUE_SET_SIZE ; i++ ){
+                if( 0uL != ( set->qPrivate.UsedMask & ( (qUINT32_t)1uL << i ) ) ){
+                    set->qPrivate.Members[ i ]->Set = NULL;
+                    set->qPrivate.Members[ i ]->SetBit = 0uL;
+                }
+            }
+        }
+        else{
+            set->qPrivate.Next = SetRegistry;
+            SetRegistry = set;
+        }
+        for( i = 0u ; i < (qUINT8_t)Q_QUEUE_SET_SIZE ; i++ ){
+            set->qPrivate.Members[ i ] = NULL;
+        }
+        set->qPrivate.ReadyMask = 0uL;
+        set->qPrivate.UsedMask = 0uL;
+        set->qPrivate.Last = (qUINT8_t)Q_QUEUE_SET_SIZE - 1u; /*the first selection starts at the first member*/
+        qCritical_Exit();
+        RetValue = qTrue;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qBool_t qQueueSetAdd( qQueueSet_t * const set, qQueue_t * const queue )
+
+Add a queue to a queue set. If the queue already holds items, the set becomes
+ready immediately.
+
+Parameters:
+
+    - set : a pointer to the queue set object
+    - queue : a pointer to the Queue object. The queue must not belong to 
+              another set and must not be a lock-free queue.
+
+Return value:
+
+    qTrue on success. qFalse if the queue can't be added or the set is full.
+*/
+qBool_t qQueueSetAdd( qQueueSet_t * const set, qQueue_t * const queue ){
+    qBool_t RetValue = qFalse;
+    qUINT8_t Index;
+
+    if( ( NULL != set ) && ( NULL != queue ) && ( NULL != queue->pHead ) ){
+        qCritical_Enter();
+        if( ( NULL == queue->Set ) && ( qFalse == queue->LockFree ) ){
+            for( Index = 0u ; Index < (qUINT8_t)Q_QUEUE_SET_SIZE ; Index++ ){
+                if( NULL == set->qPrivate.Members[ Index ] ){
+                    set->qPrivate.Members[ Index ] = queue;
+                    queue->Set = set;
+                    queue->SetBit = (qUINT32_t)1uL << Index;
+                    set->qPrivate.UsedMask |= queue->SetBit;
+                    if( queue->ItemsWaiting > 0u ){
+                        set->qPrivate.ReadyMask |= queue->SetBit;
+                    }
+                    RetValue = qTrue;
+                    break;
+                }
+            }
+        }
+        qCritical_Exit();
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qBool_t qQueueSetRemove( qQueueSet_t * const set, qQueue_t * const queue )
+
+Remove a queue from a queue set. The items in the queue are not modified.
+
+Parameters:
+
+    - set : a pointer to the queue set object
+    - queue : a pointer to the Queue object
+
+Return value:
+
+    qTrue on success. qFalse if the queue is not a member of the set.
+*/
+qBool_t qQueueSetRemove( qQueueSet_t * const set, qQueue_t * const queue ){
+    qBool_t RetValue = qFalse;
+
+    if( ( NULL != set ) && ( NULL != queue ) ){
+        qCritical_Enter();
+        if( set == queue->Set ){
+            set->qPrivate.Members[ qQueueSetLowestBit( queue->SetBit ) ] = NULL;
+            set->qPrivate.ReadyMask &= ~queue->SetBit;
+            set->qPrivate.UsedMask &= ~queue->SetBit;
+            queue->Set = NULL;
+            queue->SetBit = 0uL;
+            RetValue = qTrue;
+        }
+        qCritical_Exit();
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qBool_t qQueueSetIsReady( const qQueueSet_t * const set )
+
+Check if any of the queues in the set holds items.
+
+Parameters:
+
+    - set : a pointer to the queue set object
+
+Return value:
+
+    qTrue if at least one member holds items, otherwise returns qFalse.
+*/
+qBool_t qQueueSetIsReady( const qQueueSet_t * const set ){
+    qBool_t RetValue = qFalse;
+
+    if( NULL != set ){
+        RetValue = ( 0uL != set->qPrivate.ReadyMask )? qTrue : qFalse;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qQueue_t* qQueueSetSelect( qQueueSet_t * const set )
+
+Select a member of the set that holds items. The members are served in a
+round-robin fashion, starting after the last selected one, so a busy queue
+can't starve the others. The selection is made in constant time from the 
+ready mask, regardless of the number of members. The items are not removed 
+from the selected queue.
+
+Parameters:
+
+    - set : a pointer to the queue set object
+
+Return value:
+
+    A pointer to the selected queue, or NULL if no member holds items.
+*/
+qQueue_t* qQueueSetSelect( qQueueSet_t * const set ){
+    qQueue_t *RetValue = NULL;
+    qUINT32_t Ready, After;
+
+    if( NULL != set ){
+        qCritical_Enter();
+        Ready = set->qPrivate.ReadyMask;
+        if( 0uL != Ready ){
+            After = Ready & ~( (qUINT32_t)( (qUINT32_t)2uL << set->qPrivate.Last ) - 1uL ); /*the members after the last selected one*/
+            set->qPrivate.Last = qQueueSetLowestBit( ( 0uL != After )? After : Ready );
+            RetValue = set->qPrivate.Members[ set->qPrivate.Last ];
+        }
+        qCritical_Exit();
+    }
+    return RetValue;
+}
+/*============================================================================*/
+static void qQueueSetDetach( const qQueue_t * const queue ){
+    qQueueSet_t *iSet;
+    qUINT32_t Bit;
+    qUINT8_t i;
+
+    qCritical_Enter();
+    for( iSet = SetRegistry ; NULL != iSet ; iSet = iSet->qPrivate.Next ){
+        for( i = 0u ; i < (qUINT8_t)Q_QUEUE_SET_SIZE ; i++ ){
+            if( queue == iSet->qPrivate.Members[ i ] ){
+                Bit = (qUINT32_t)1uL << i;
+                iSet->qPrivate.Members[ i ] = NULL;
+                iSet->qPrivate.ReadyMask &= ~Bit;
+                iSet->qPrivate.UsedMask &= ~Bit;
+            }
+        }
+    }
+    qCritical_Exit();
+}
+/*============================================================================*/
+static qUINT8_t qQueueSetLowestBit( const qUINT32_t mask ){
+    static const qUINT8_t DeBruijnIndex[ 32 ] = { 0u, 1u, 28u, 2u, 29u, 14u, 24u, 3u, 30u, 22u, 20u, 15u, 25u, 17u, 4u, 8u, 
+                                                  31u, 27u, 13u, 23u, 21u, 19u, 16u, 7u, 26u, 12u, 18u, 6u, 11u, 5u, 10u, 9u };
+    qUINT32_t Lowest = mask & ( ~mask + 1uL ); /*isolate the lowest set bit*/
+
+    return DeBruijnIndex[ (qUINT32_t)( Lowest*0x077CB531uL ) >> 27 ];
+}
+#endif /* #if ( Q_QUEUE_SET_SIZE > 0 ) */
+/*============================================================================*/
 
-#endif /* #if (Q_QUEUES == 1) */
\ No newline at end of file
+#endif /* #if (Q_QUEUES == 1) */
@@ -0,0 +1,414 @@
+#include "qreplay.h"
+
+#if ( Q_REPLAY == 1 )
+
+#define QREPLAY_REC_TICK            ( 0x01u )   /*< One tick read: varint delta from the previous value. */
+#define QREPLAY_REC_REPEAT          ( 0x02u )   /*< varint count of reads that returned the previous value again. */
+#define QREPLAY_REC_NOTIFY          ( 0x03u )   /*< Simple notification: varint task id, varint data id. */
+#define QREPLAY_REC_QNOTIFY         ( 0x04u )   /*< Queued notification: varint task id, varint data id. */
+#define QREPLAY_REC_EVENTFLAGS      ( 0x05u )   /*< Event flags: varint task id, varint flags, action byte. */
+#define QREPLAY_REC_QUEUESEND       ( 0x06u )   /*< Queue insert: varint queue id, mode byte, raw item bytes. */
+
+#define QREPLAY_VARINT_MAXSIZE      ( 5u )      /*< Max bytes needed to encode a 32-bit value. */
+
+typedef struct{
+    void *Objects[ Q_REPLAY_OBJECTS ];  /*< The registered objects. The stream refers to them by index+1. */
+    size_t ObjectsCount;                /*< The number of registered objects. */
+    qReplayWriteFcn_t Output;           /*< The output function used while recording. */
+    qReplayReadFcn_t Input;             /*< The input function used while replaying. */
+    void *arg;                          /*< The argument passed to the stream functions. */
+    qClock_t LastTick;                  /*< The last tick value recorded or replayed. */
+    qUINT32_t Repeats;                  /*< Pending repeated reads of <LastTick>. */
+    #if ( Q_QUEUES == 1 )
+        qUINT8_t Item[ Q_REPLAY_MAX_ITEM_SIZE ];    /*< Used to rebuild the queue items while replaying. */
+    #endif
+    volatile qReplayState_t State;
+}qReplayHandler_t;
+
+static qReplayHandler_t Replay;
+
+static size_t qReplay_IdOf( const void * const Object );
+static void* qReplay_ObjectOf( const qUINT32_t Id );
+static size_t qReplay_PutVarint( qUINT8_t *buffer, qUINT32_t Value );
+static void qReplay_FlushRepeats( void );
+static void qReplay_WriteRecord( const qUINT8_t Type, const qUINT32_t a, const qUINT32_t b );
+static qBool_t qReplay_GetByte( qUINT8_t *Value );
+static qBool_t qReplay_GetVarint( qUINT32_t *Value );
+static qBool_t qReplay_Inject( const qUINT8_t Type );
+
+/*============================================================================*/
+static size_t qReplay_IdOf( const void * const Object ){
+    size_t i, RetValue = 0u;
+    if( NULL != Object ){
+        for( i = 0u ; i < Replay.ObjectsCount ; i++ ){
+            if( Object == Replay.Objects[ i ] ){
+                RetValue = i + 1u;
+                break;
+            }
+        }
+    }
+    return RetValue;
+}
+/*============================================================================*/
+static void* qReplay_ObjectOf( const qUINT32_t Id ){
+    return ( ( Id > 0uL ) && ( Id <= (qUINT32_t)Replay.ObjectsCount ) )? Replay.Objects[ Id - 1uL ] : NULL;
+}
+/*============================================================================*/
+static size_t qReplay_PutVarint( qUINT8_t *buffer, qUINT32_t Value ){
+    size_t n = 0u;
+    while( Value >= 0x80uL ){
+        buffer[ n++ ] = (qUINT8_t)( ( Value & 0x7FuL ) | 0x80uL );
+        Value >>= 7;
+    }
+    buffer[ n++ ] = (qUINT8_t)Value;
+    return n;
+}
+/*============================================================================*/
+static void qReplay_FlushRepeats( void ){
+    qUINT8_t buffer[ 1u + QREPLAY_VARINT_MAXSIZE ];
+    if( Replay.Repeats > 0uL ){
+        buffer[ 0 ] = QREPLAY_REC_REPEAT;
+        Replay.Output( buffer, 1u + qReplay_PutVarint( &buffer[ 1 ], Replay.Repeats ), Replay.arg );
+        Replay.Repeats = 0uL;
+    }
+}
+/*============================================================================*/
+static void qReplay_WriteRecord( const qUINT8_t Type, const qUINT32_t a, const qUINT32_t b ){
+    qUINT8_t buffer[ 1u + ( 2u*QREPLAY_VARINT_MAXSIZE ) ];
+    size_t n;
+    qReplay_FlushRepeats();
+    buffer[ 0 ] = Type;
+    n = 1u + qReplay_PutVarint( &buffer[ 1 ], a );
+    if( QREPLAY_REC_TICK != Type ){
+        n += qReplay_PutVarint( &buffer[ n ], b );
+    }
+    Replay.Output( buffer, n, Replay.arg );
+}
+/*============================================================================*/
+static qBool_t qReplay_GetByte( qUINT8_t *Value ){
+    return ( 1u == Replay.Input( Value, 1u, Replay.arg ) )? qTrue : qFalse;
+}
+/*============================================================================*/
+static qBool_t qReplay_GetVarint( qUINT32_t *Value ){
+    qBool_t RetValue = qFalse;
+    qUINT8_t byte;
+    qUINT8_t shift = 0u;
+    *Value = 0uL;
+    while( ( shift < 35u ) && ( qTrue == qReplay_GetByte( &byte ) ) ){
+        *Value |= ( (qUINT32_t)byte & 0x7FuL ) << shift;
+        if( 0u == ( byte & 0x80u ) ){
+            RetValue = qTrue;
+            break;
+        }
+        shift += 7u;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+static qBool_t qReplay_Inject( const qUINT8_t Type ){
+    qBool_t RetValue = qFalse;
+    qUINT32_t Id, Value;
+    qUINT8_t Action;
+    #if ( Q_QUEUES == 1 )
+        qQueue_t *Queue;
+    #endif
+
+    if( qTrue == qReplay_GetVarint( &Id ) ){
+        switch( Type ){
+            case QREPLAY_REC_NOTIFY: case QREPLAY_REC_QNOTIFY:
+                if( qTrue == qReplay_GetVarint( &Value ) ){
+                    if( QREPLAY_REC_NOTIFY == Type ){
+                        (void)qTaskSendNotification( (qTask_t*)qReplay_ObjectOf( Id ), qReplay_ObjectOf( Value ) );
+                    }
+                    else{
+                        (void)qTaskQueueNotification( (qTask_t*)qReplay_ObjectOf( Id ), qReplay_ObjectOf( Value ) );
+                    }
+                    RetValue = qTrue;
+                }
+                break;
+            case QREPLAY_REC_EVENTFLAGS:
+                if( ( qTrue == qReplay_GetVarint( &Value ) ) && ( qTrue == qReplay_GetByte( &Action ) ) ){
+                    qTaskModifyEventFlags( (qTask_t*)qReplay_ObjectOf( Id ), (qTaskFlag_t)Value, (qBool_t)Action );
+                    RetValue = qTrue;
+                }
+                break;
+            #if ( Q_QUEUES == 1 )
+            case QREPLAY_REC_QUEUESEND:
+                Queue = (qQueue_t*)qReplay_ObjectOf( Id );
+                if( ( NULL != Queue ) && ( Queue->ItemSize <= sizeof(Replay.Item) ) && ( qTrue == qReplay_GetByte( &Action ) ) ){
+                    if( Queue->ItemSize == Replay.Input( Replay.Item, Queue->ItemSize, Replay.arg ) ){
+                        (void)qQueueGenericSend( Queue, Replay.Item, (qQueueMode_t)Action );
+                        RetValue = qTrue;
+                    }
+                }
+                break;
+            #endif
+            default:
+                break;
+        }
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qBool_t qReplay_Register( void * const Object )
+
+Register an object (task, queue or any event-data) so it can be referenced
+from the record/replay stream. The registration order must be the same in
+the recording and the replaying application. Objects that are not registered
+are replayed as NULL.
+
+Parameters:
+
+    - Object : A pointer to the object
+
+Return value:
+
+    qTrue on success, otherwise returns qFalse (registry full or
+    the object is already registered).
+*/
+qBool_t qReplay_Register( void * const Object ){
+    qBool_t RetValue = qFalse;
+    if( ( NULL != Object ) && ( Replay.ObjectsCount < (size_t)Q_REPLAY_OBJECTS ) && ( 0u == qReplay_IdOf( Object ) ) ){
+        Replay.Objects[ Replay.ObjectsCount++ ] = Object;
+        RetValue = qTrue;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qBool_t qReplay_StartRecording( const qReplayWriteFcn_t Output, void *arg )
+
+Start the recording of the kernel inputs.
+
+Parameters:
+
+    - Output : The function that stores the stream bytes. It can be called
+               from the qReplay_*FromISR wrappers, so it must be safe to
+               call it from the interrupt context (i.e. a RAM ring buffer).
+               Should have this prototype:
+               void Output( const void *src, size_t n, void *arg )
+    - arg : The argument passed to <Output>
+
+Return value:
+
+    qTrue on success, otherwise returns qFalse.
+*/
+qBool_t qReplay_StartRecording( const qReplayWriteFcn_t Output, void *arg ){
+    qBool_t RetValue = qFalse;
+    if( NULL != Output ){
+        qCritical_Enter();
+        Replay.Output = Output;
+        Replay.Input = NULL;
+        Replay.arg = arg;
+        Replay.LastTick = 0uL;
+        Replay.Repeats = 0uL;
+        Replay.State = qReplay_Recording;
+        qCritical_Exit();
+        RetValue = qTrue;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*qBool_t qReplay_StartReplay( const qReplayReadFcn_t Input, void *arg )
+
+Start the replay of a recorded stream. From now on, qClock_GetTick returns the
+recorded values and the recorded inputs are injected again, so the scheduler
+runs as fast as possible. When the stream ends, the state changes to
+qReplay_Finished, the tick remains frozen and the scheduler is released
+(if Q_ALLOW_SCHEDULER_RELEASE is enabled).
+
+Parameters:
+
+    - Input : The function that provides the stream bytes. Should have this
+              prototype: size_t Input( void *dst, size_t n, void *arg ) and
+              return the number of bytes read.
+    - arg : The argument passed to <Input>
+
+Return value:
+
+    qTrue on success, otherwise returns qFalse.
+*/
+qBool_t qReplay_StartReplay( const qReplayReadFcn_t Input, void *arg ){
+    qBool_t RetValue = qFalse;
+    if( NULL != Input ){
+        Replay.Input = Input;
+        Replay.Output = NULL;
+        Replay.arg = arg;
+        Replay.LastTick = 0uL;
+        Replay.Repeats = 0uL;
+        Replay.State = qReplay_Replaying;
+        RetValue = qTrue;
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*void qReplay_Stop( void )
+
+Stop the recording (flushing the pending records) or the replay.
+*/
+void qReplay_Stop( void ){
+    qCritical_Enter();
+    if( qReplay_Recording == Replay.State ){
+        qReplay_FlushRepeats();
+    }
+    Replay.State = qReplay_Idle;
+    qCritical_Exit();
+}
+/*============================================================================*/
+/*qReplayState_t qReplay_GetState( void )
+
+Returns the current state of the record/replay module.
+
+Return value:
+
+    qReplay_Idle, qReplay_Recording, qReplay_Replaying or qReplay_Finished.
+*/
+qReplayState_t qReplay_GetState( void ){
+    return Replay.State;
+}
+/*============================================================================*/
+/*qBool_t qReplay_SendNotificationFromISR( qTask_t * const Task, void *eventdata )
+
+Same as qTaskSendNotification, but the input is recorded. Use it in the
+interrupt or external contexts that notify tasks.
+
+Return value:
+
+    The return value of qTaskSendNotification.
+*/
+qBool_t qReplay_SendNotificationFromISR( qTask_t * const Task, void *eventdata ){
+    if( qReplay_Recording == Replay.State ){
+        qCritical_Enter();
+        qReplay_WriteRecord( QREPLAY_REC_NOTIFY, (qUINT32_t)qReplay_IdOf( Task ), (qUINT32_t)qReplay_IdOf( eventdata ) );
+        qCritical_Exit();
+    }
+    return qTaskSendNotification( Task, eventdata );
+}
+/*============================================================================*/
+/*qBool_t qReplay_QueueNotificationFromISR( qTask_t * const Task, void *eventdata )
+
+Same as qTaskQueueNotification, but the input is recorded. Use it in the
+interrupt or external contexts that notify tasks.
+
+Return value:
+
+    The return value of qTaskQueueNotification.
+*/
+qBool_t qReplay_QueueNotificationFromISR( qTask_t * const Task, void *eventdata ){
+    if( qReplay_Recording == Replay.State ){
+        qCritical_Enter();
+        qReplay_WriteRecord( QREPLAY_REC_QNOTIFY, (qUINT32_t)qReplay_IdOf( Task ), (qUINT32_t)qReplay_IdOf( eventdata ) );
+        qCritical_Exit();
+    }
+    return qTaskQueueNotification( Task, eventdata );
+}
+/*============================================================================*/
+/*void qReplay_ModifyEventFlagsFromISR( qTask_t * const Task, qTaskFlag_t flags, qBool_t action )
+
+Same as qTaskModifyEventFlags, but the input is recorded. Use it in the
+interrupt or external contexts that modify the task event-flags.
+*/
+void qReplay_ModifyEventFlagsFromISR( qTask_t * const Task, qTaskFlag_t flags, qBool_t action ){
+    qUINT8_t Action = (qUINT8_t)action;
+    if( qReplay_Recording == Replay.State ){
+        qCritical_Enter();
+        qReplay_WriteRecord( QREPLAY_REC_EVENTFLAGS, (qUINT32_t)qReplay_IdOf( Task ), (qUINT32_t)flags );
+        Replay.Output( &Action, 1u, Replay.arg );
+        qCritical_Exit();
+    }
+    qTaskModifyEventFlags( Task, flags, action );
+}
+/*============================================================================*/
+#if ( Q_QUEUES == 1 )
+/*qBool_t qReplay_QueueSendFromISR( qQueue_t * const Queue, void *ItemToQueue, qQueueMode_t InsertMode )
+
+Same as qQueueGenericSend, but the input is recorded including a copy of the
+item. Use it in the interrupt or external contexts that feed queues.
+Items larger than Q_REPLAY_MAX_ITEM_SIZE are not recorded.
+
+Return value:
+
+    The return value of qQueueGenericSend.
+*/
+qBool_t qReplay_QueueSendFromISR( qQueue_t * const Queue, void *ItemToQueue, qQueueMode_t InsertMode ){
+    if( ( qReplay_Recording == Replay.State ) && ( NULL != Queue ) && ( NULL != ItemToQueue ) && ( Queue->ItemSize <= (size_t)Q_REPLAY_MAX_ITEM_SIZE ) ){
+        qCritical_Enter();
+        qReplay_WriteRecord( QREPLAY_REC_QUEUESEND, (qUINT32_t)qReplay_IdOf( Queue ), (qUINT32_t)InsertMode );
+        Replay.Output( ItemToQueue, Queue->ItemSize, Replay.arg );
+        qCritical_Exit();
+    }
+    return qQueueGenericSend( Queue, ItemToQueue, InsertMode );
+}
+#endif
+/*============================================================================*/
+/*
+    PRIVATE : THIS FUNCTION IS NOT INTENDED FOR THE USER USAGE
+
+Invoked by qClock_GetTick with the value obtained from the tick provider.
+Returns the value that the kernel must use.
+*/
+qClock_t __qPrivate_ReplayTick( const qClock_t Tick ){
+    qClock_t RetValue = Tick;
+    qUINT32_t Value;
+    qUINT8_t Type;
+    qBool_t Done = qFalse;
+
+    if( qReplay_Recording == Replay.State ){
+        qCritical_Enter();
+        if( ( Tick == Replay.LastTick ) && ( Replay.Repeats < 0xFFFFFFFFuL ) ){
+            Replay.Repeats++;
+        }
+        else{
+            qReplay_WriteRecord( QREPLAY_REC_TICK, (qUINT32_t)( Tick - Replay.LastTick ), 0uL );
+            Replay.LastTick = Tick;
+        }
+        qCritical_Exit();
+    }
+    else if( qReplay_Replaying == Replay.State ){
+        if( Replay.Repeats > 0uL ){
+            Replay.Repeats--;
+            Done = qTrue;
+        }
+        while( qFalse == Done ){ /*inject the inputs until the next tick read is found*/
+            if( qFalse == qReplay_GetByte( &Type ) ){
+                Type = 0u;
+            }
+            if( ( QREPLAY_REC_TICK == Type ) || ( QREPLAY_REC_REPEAT == Type ) ){
+                if( qFalse == qReplay_GetVarint( &Value ) ){
+                    Type = 0u;
+                }
+                else if( QREPLAY_REC_TICK == Type ){
+                    Replay.LastTick += (qClock_t)Value;
+                    Done = qTrue;
+                }
+                else{
+                    Replay.Repeats = ( Value > 0uL )? ( Value - 1uL ) : 0uL;
+                    Done = qTrue;
+                }
+            }
+            else if( ( 0u != Type ) && ( qTrue == qReplay_Inject( Type ) ) ){
+                /*input injected, continue with the next record*/
+            }
+            else{
+                Type = 0u;
+            }
+            if( 0u == Type ){ /*end of stream or corrupted record*/
+                Replay.State = qReplay_Finished;
+                #if ( Q_ALLOW_SCHEDULER_RELEASE == 1 )
+                    qSchedulerRelease();
+                #endif
+                Done = qTrue;
+            }
+        }
+        RetValue = Replay.LastTick;
+    }
+    else if( qReplay_Finished == Replay.State ){
+        RetValue = Replay.LastTick;
+    }
+    else{
+        /*nothing to do*/
+    }
+    return RetValue;
+}
+/*============================================================================*/
+
+#endif /* #if ( Q_REPLAY == 1 ) */
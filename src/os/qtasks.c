@@ -106,6 +106,29 @@ qCycles_t qTaskGetCycles( const qTask_t * const Task ){
     return RetValue;
 }
 #endif
+#if ( Q_SCHEDULER_LOAD == 1 )
+/*============================================================================*/
+/*qUINT16_t qTaskGetLoad(const qTask_t *Task)
+
+Retrieve the CPU load of the task, measured as the time spent in its callback 
+during the last completed measurement window. See qSchedulerGetLoad.
+
+Parameters:
+
+    - Task : Pointer to the task node.
+
+Return value:
+
+    The task load in per-mille (0 to 1000).
+*/
+qUINT16_t qTaskGetLoad( const qTask_t * const Task ){
+    qUINT16_t RetValue = 0u;
+    if( NULL != Task ){
+        RetValue = Task->qPrivate.Load;
+    }
+    return RetValue;
+}
+#endif
 /*============================================================================*/
 /*void qTaskSetTime(qTask_t * const Task, const qTime_t Value)
 
@@ -232,6 +255,50 @@ void qTaskSetData( qTask_t * const Task, void* arg ){
         Task->qPrivate.TaskData = arg;
     }
 }
+#if ( Q_TASK_REGISTRY == 1 )
+/*============================================================================*/
+/*qBool_t qTaskSetName( qTask_t * const Task, const char *Name )
+
+Set the name of the task. The name is used by qSchedulerFindTask to find 
+the task. It can be set before or after the task is added to the scheduling
+scheme.
+
+Parameters:
+
+    - Task : A pointer to the task node.
+    - Name : A NULL-terminated string that must remain valid while the task
+             is in the scheduling scheme. Pass NULL to remove the name.
+
+Return value:
+
+    Returns qTrue on success. qFalse if another registered task has 
+    the same name.
+*/
+qBool_t qTaskSetName( qTask_t * const Task, const char *Name ){
+    qBool_t RetValue = qFalse;
+    if( NULL != Task ){
+        RetValue = _qScheduler_RegistryRename( Task, Name );
+    }
+    return RetValue;
+}
+/*============================================================================*/
+/*const char* qTaskGetName( const qTask_t * const Task )
+
+Returns the name of the task or NULL if the task has no name.
+*/
+const char* qTaskGetName( const qTask_t * const Task ){
+    return ( NULL != Task )? Task->qPrivate.Name : NULL;
+}
+/*============================================================================*/
+/*qUINT32_t qTaskGetID( const qTask_t * const Task )
+
+Returns the identifier assigned to the task by qSchedulerAdd_Task or 0(zero)
+if the task has never been added to the scheduling scheme.
+*/
+qUINT32_t qTaskGetID( const qTask_t * const Task ){
+    return ( NULL != Task )? Task->qPrivate.ID : 0uL;
+}
+#endif /* #if ( Q_TASK_REGISTRY == 1 ) */
 /*============================================================================*/
 /*void qTaskClearTimeElapsed(qTask_t *Task)
 
@@ -293,12 +360,109 @@ qBool_t qTaskAttachQueue( qTask_t * const Task, qQueue_t * const Queue, const qQ
                 Task->qPrivate.QueueCount = arg; /*if mode is qQUEUE_COUNT, use their arg value as count*/
             }
             Task->qPrivate.Queue = ( arg > 0u )? Queue : NULL; /*reject, no valid arg input*/
+            Task->qPrivate.PQueue = NULL; /*only one queue can be attached*/
             RetValue = qTrue;
         }
     }
     return RetValue;
 }
+/*============================================================================*/
+/*qBool_t qTaskAttachPQueue( qTask_t * const Task, qPQueue_t * const PQueue, const qQueueLinkMode_t Mode, const qUINT16_t arg )
+
+Attach a priority queue to the Task. The link modes and the triggers are the 
+same of qTaskAttachQueue. With qQUEUE_RECEIVER, the item with the highest 
+priority is taken out of the queue and a pointer to it will be available in 
+the <EventData> field, so it can be processed in place. Its slot is released
+after the task callback returns. Attaching a priority queue detaches any 
+qQueue previously attached.
+
+Parameters:
+
+    - Task : A pointer to the task node.
+    - PQueue : A pointer to the priority queue object
+    - Mode : Attach mode. See qTaskAttachQueue.
+    - arg: qATTACH or qDETACH. If the qQUEUE_COUNT mode is specified, this 
+           value will be used to check the element count of the queue. A 
+           zero value will act as a qDETACH action.
+
+Return value:
+
+    Returns qTrue on success, otherwise returns qFalse;
+*/
+qBool_t qTaskAttachPQueue( qTask_t * const Task, qPQueue_t * const PQueue, const qQueueLinkMode_t Mode, const qUINT16_t arg ){
+    qBool_t RetValue = qFalse;
+    if( ( NULL != PQueue ) && ( NULL != Task ) ){
+        __qPrivate_TaskModifyFlags( Task, Mode & __QTASK_QUEUEFLAGS_MASK, (( arg != 0u )? qATTACH :qDETACH) );
+        if( Mode == qQUEUE_COUNT ){
+            Task->qPrivate.QueueCount = arg; /*if mode is qQUEUE_COUNT, use their arg value as count*/
+        }
+        Task->qPrivate.PQueue = ( arg > 0u )? PQueue : NULL;
+        Task->qPrivate.Queue = NULL; /*only one queue can be attached*/
+        RetValue = qTrue;
+    }
+    return RetValue;
+}
+#if ( Q_QUEUE_SET_SIZE > 0 )
+/*============================================================================*/
+/*qBool_t qTaskAttachQueueSet( qTask_t * const Task, qQueueSet_t * const Set )
+
+Attach a queue set to the Task. The task will be triggered with the 
+byQueueSet trigger every time any of the queues in the set has items. A 
+pointer to the member queue that triggered the task will be available in the
+<EventData> field of the qEvent_t structure. Unlike the qQUEUE_RECEIVER mode,
+the items are not removed automatically, the task should receive them from
+the reported queue.
+
+Parameters:
+
+    - Task : A pointer to the task node.
+    - Set : A pointer to the queue set object. Pass NULL to detach the
+            current set.
+
+Return value:
+
+    Returns qTrue on success, otherwise returns qFalse;
+*/
+qBool_t qTaskAttachQueueSet( qTask_t * const Task, qQueueSet_t * const Set ){
+    qBool_t RetValue = qFalse;
+    if( NULL != Task ){
+        Task->qPrivate.QueueSet = Set;
+        RetValue = qTrue;
+    }
+    return RetValue;
+}
+#endif /* #if ( Q_QUEUE_SET_SIZE > 0 ) */
 #endif /* #if ( Q_QUEUES == 1) */
+#if ( Q_CHANNELS == 1 )
+/*============================================================================*/
+/*qBool_t qTaskAttachChannel( qTask_t * const Task, qChannel_t * const Channel )
+
+Attach a channel to the Task. The task will be triggered with the 
+byChannelReceiver trigger every time there are items available in the channel.
+A pointer to the item at the front will be available in the <EventData> field
+of the qEvent_t structure, and it will be removed after the task callback 
+returns. 
+The task becomes the only consumer of the channel.
+
+Parameters:
+
+    - Task : A pointer to the task node.
+    - Channel : A pointer to the channel object. Pass NULL to detach the
+                current channel.
+
+Return value:
+
+    Returns qTrue on success, otherwise returns qFalse;
+*/
+qBool_t qTaskAttachChannel( qTask_t * const Task, qChannel_t * const Channel ){
+    qBool_t RetValue = qFalse;
+    if( NULL != Task ){
+        Task->qPrivate.Channel = Channel;
+        RetValue = qTrue;
+    }
+    return RetValue;
+}
+#endif /* #if ( Q_CHANNELS == 1 ) */
 #if ( Q_FSM == 1)
 /*============================================================================*/
 /*qBool_t qTaskAttachStateMachine( qTask_t * const Task, qSM_t * const StateMachine )
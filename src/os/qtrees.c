@@ -0,0 +1,542 @@
+#include "qtrees.h"
+
+#define QTREE_RED       ( (qUINT8_t)0u )
+#define QTREE_BLACK     ( (qUINT8_t)1u )
+#define QTREE_IS_BLACK( n )     ( ( NULL == (n) ) || ( QTREE_BLACK == (n)->__qTreeColor ) )
+
+static void qTree_RotateLeft( qTree_t * const tree, qTreeNode_t * const x );
+static void qTree_RotateRight( qTree_t * const tree, qTreeNode_t * const x );
+static void qTree_InsertFixup( qTree_t * const tree, qTreeNode_t *z );
+static void qTree_RemoveFixup( qTree_t * const tree, qTreeNode_t *x, qTreeNode_t *xParent );
+static void qTree_Transplant( qTree_t * const tree, const qTreeNode_t * const u, qTreeNode_t * const v );
+static qTreeNode_t* qTree_Leftmost( qTreeNode_t *node );
+static qTreeNode_t* qTree_Rightmost( qTreeNode_t *node );
+
+/*=========================================================*/
+static qTreeNode_t* qTree_Leftmost( qTreeNode_t *node ){
+    if( NULL != node ){
+        while( NULL != node->__qTreeLeft ){
+            node = node->__qTreeLeft;
+        }
+    }
+    return node;
+}
+/*=========================================================*/
+static qTreeNode_t* qTree_Rightmost( qTreeNode_t *node ){
+    if( NULL != node ){
+        while( NULL != node->__qTreeRight ){
+            node = node->__qTreeRight;
+        }
+    }
+    return node;
+}
+/*=========================================================*/
+static void qTree_RotateLeft( qTree_t * const tree, qTreeNode_t * const x ){
+    qTreeNode_t *y = x->__qTreeRight;
+
+    x->__qTreeRight = y->__qTreeLeft;
+    if( NULL != y->__qTreeLeft ){
+        y->__qTreeLeft->__qTreeParent = x;
+    }
+    qTree_Transplant( tree, x, y );
+    y->__qTreeLeft = x;
+    x->__qTreeParent = y;
+}
+/*=========================================================*/
+static void qTree_RotateRight( qTree_t * const tree, qTreeNode_t * const x ){
+    qTreeNode_t *y = x->__qTreeLeft;
+
+    x->__qTreeLeft = y->__qTreeRight;
+    if( NULL != y->__qTreeRight ){
+        y->__qTreeRight->__qTreeParent = x;
+    }
+    qTree_Transplant( tree, x, y );
+    y->__qTreeRight = x;
+    x->__qTreeParent = y;
+}
+/*=========================================================*/
+static void qTree_Transplant( qTree_t * const tree, const qTreeNode_t * const u, qTreeNode_t * const v ){ /*put <v> in the place of <u>*/
+    qTreeNode_t *Parent = u->__qTreeParent;
+
+    if( NULL == Parent ){
+        tree->qPrivate.Root = v;
+    }
+    else if( u == Parent->__qTreeLeft ){
+        Parent->__qTreeLeft = v;
+    }
+    else{
+        Parent->__qTreeRight = v;
+    }
+    if( NULL != v ){
+        v->__qTreeParent = Parent;
+    }
+}
+/*=========================================================*/
+static void qTree_InsertFixup( qTree_t * const tree, qTreeNode_t *z ){
+    qTreeNode_t *Parent, *Grandparent, *Uncle;
+
+    while( ( NULL != ( Parent = z->__qTreeParent ) ) && ( QTREE_RED == Parent->__qTreeColor ) ){
+        Grandparent = Parent->__qTreeParent; /*exists, a red node is never the root*/
+        if( Parent == Grandparent->__qTreeLeft ){
+            Uncle = Grandparent->__qTreeRight;
+            if( !QTREE_IS_BLACK( Uncle ) ){ /*recolor and move up*/
+                Parent->__qTreeColor = QTREE_BLACK;
+                Uncle->__qTreeColor = QTREE_BLACK;
+                Grandparent->__qTreeColor = QTREE_RED;
+                z = Grandparent;
+            }
+            else{
+                if( z == Parent->__qTreeRight ){
+                    z = Parent;
+                    qTree_RotateLeft( tree, z );
+                    Parent = z->__qTreeParent;
+                }
+                Parent->__qTreeColor = QTREE_BLACK;
+                Grandparent->__qTreeColor = QTREE_RED;
+                qTree_RotateRight( tree, Grandparent );
+            }
+        }
+        else{
+            Uncle = Grandparent->__qTreeLeft;
+            if( !QTREE_IS_BLACK( Uncle ) ){
+                Parent->__qTreeColor = QTREE_BLACK;
+                Uncle->__qTreeColor = QTREE_BLACK;
+                Grandparent->__qTreeColor = QTREE_RED;
+                z = Grandparent;
+            }
+            else{
+                if( z == Parent->__qTreeLeft ){
+                    z = Parent;
+                    qTree_RotateRight( tree, z );
+                    Parent = z->__qTreeParent;
+                }
+                Parent->__qTreeColor = QTREE_BLACK;
+                Grandparent->__qTreeColor = QTREE_RED;
+                qTree_RotateLeft( tree, Grandparent );
+            }
+        }
+    }
+    tree->qPrivate.Root->__qTreeColor = QTREE_BLACK;
+}
+/*=========================================================*/
+static void qTree_RemoveFixup( qTree_t * const tree, qTreeNode_t *x, qTreeNode_t *xParent ){
+    qTreeNode_t *w;
+
+    while( ( x != tree->qPrivate.Root ) && QTREE_IS_BLACK( x ) ){ /*<x> can be NULL, so its parent is tracked apart*/
+        if( x == xParent->__qTreeLeft ){
+            w = xParent->__qTreeRight;
+            if( QTREE_RED == w->__qTreeColor ){
+                w->__qTreeColor = QTREE_BLACK;
+                xParent->__qTreeColor = QTREE_RED;
+                qTree_RotateLeft( tree, xParent );
+                w = xParent->__qTreeRight;
+            }
+            if( QTREE_IS_BLACK( w->__qTreeLeft ) && QTREE_IS_BLACK( w->__qTreeRight ) ){
+                w->__qTreeColor = QTREE_RED;
+                x = xParent;
+                xParent = x->__qTreeParent;
+            }
+            else{
+                if( QTREE_IS_BLACK( w->__qTreeRight ) ){
+                    w->__qTreeLeft->__qTreeColor = QTREE_BLACK;
+                    w->__qTreeColor = QTREE_RED;
+                    qTree_RotateRight( tree, w );
+                    w = xParent->__qTreeRight;
+                }
+                w->__qTreeColor = xParent->__qTreeColor;
+                xParent->__qTreeColor = QTREE_BLACK;
+                w->__qTreeRight->__qTreeColor = QTREE_BLACK;
+                qTree_RotateLeft( tree, xParent );
+                x = tree->qPrivate.Root;
+            }
+        }
+        else{
+            w = xParent->__qTreeLeft;
+            if( QTREE_RED == w->__qTreeColor ){
+                w->__qTreeColor = QTREE_BLACK;
+                xParent->__qTreeColor = QTREE_RED;
+                qTree_RotateRight( tree, xParent );
+                w = xParent->__qTreeLeft;
+            }
+            if( QTREE_IS_BLACK( w->__qTreeLeft ) && QTREE_IS_BLACK( w->__qTreeRight ) ){
+                w->__qTreeColor = QTREE_RED;
+                x = xParent;
+                xParent = x->__qTreeParent;
+            }
+            else{
+                if( QTREE_IS_BLACK( w->__qTreeLeft ) ){
+                    w->__qTreeRight->__qTreeColor = QTREE_BLACK;
+                    w->__qTreeColor = QTREE_RED;
+                    qTree_RotateLeft( tree, w );
+                    w = xParent->__qTreeLeft;
+                }
+                w->__qTreeColor = xParent->__qTreeColor;
+                xParent->__qTreeColor = QTREE_BLACK;
+                w->__qTreeLeft->__qTreeColor = QTREE_BLACK;
+                qTree_RotateRight( tree, xParent );
+                x = tree->qPrivate.Root;
+            }
+        }
+    }
+    if( NULL != x ){
+        x->__qTreeColor = QTREE_BLACK;
+    }
+}
+/*=========================================================*/
+/*qBool_t qTree_Initialize( qTree_t * const tree, const qTreeCompareFcn_t CompareFcn )
+
+Must be called before a tree is used! This initialises all the members
+of the tree structure.
+
+Parameters:
+
+    - tree : Pointer to the tree being initialised.
+    - CompareFcn : The function that defines the order of the nodes.
+                   Should have this prototype:
+                   int Function( const void *n1, const void *n2 )
+                   and return a negative value if <n1> goes before <n2>,
+                   a positive value if <n1> goes after <n2> or 0(zero)
+                   if both are equivalent.
+
+Return value:
+
+    qTrue on success, otherwise returns qFalse.
+*/
+qBool_t qTree_Initialize( qTree_t * const tree, const qTreeCompareFcn_t CompareFcn ){
+    qBool_t RetValue = qFalse;
+    if( ( NULL != tree ) && ( NULL != CompareFcn ) ){
+        tree->qPrivate.Root = NULL;
+        tree->qPrivate.CompareFcn = CompareFcn;
+        tree->qPrivate.Count = 0u;
+        RetValue = qTrue;
+    }
+    return RetValue;
+}
+/*=========================================================*/
+/*qBool_t qTree_Insert( qTree_t * const tree, void * const node )
+
+Insert a node into the tree. A node equivalent to others is placed
+after them.
+
+Parameters:
+
+    - tree : Pointer to the tree.
+    - node : A pointer to the node to be inserted. The node must not
+             belong to another tree.
+
+Return value:
+
+    qTrue on success, otherwise returns qFalse.
+*/
+qBool_t qTree_Insert( qTree_t * const tree, void * const node ){
+    qBool_t RetValue = qFalse;
+    qTreeNode_t *xNode = (qTreeNode_t*)node;
+    qTreeNode_t *Parent = NULL, *iNode;
+    int Cmp = 0;
+
+    if( ( NULL != tree ) && ( NULL != xNode ) ){
+        if( NULL == xNode->__qTreeContainer ){
+            for( iNode = tree->qPrivate.Root ; NULL != iNode ; iNode = ( Cmp < 0 )? iNode->__qTreeLeft : iNode->__qTreeRight ){
+                Parent = iNode;
+                Cmp = tree->qPrivate.CompareFcn( xNode, iNode );
+            }
+            xNode->__qTreeLeft = NULL;
+            xNode->__qTreeRight = NULL;
+            xNode->__qTreeParent = Parent;
+            xNode->__qTreeColor = QTREE_RED;
+            xNode->__qTreeContainer = tree;
+            if( NULL == Parent ){
+                tree->qPrivate.Root = xNode;
+            }
+            else if( Cmp < 0 ){
+                Parent->__qTreeLeft = xNode;
+            }
+            else{
+                Parent->__qTreeRight = xNode;
+            }
+            qTree_InsertFixup( tree, xNode );
+            tree->qPrivate.Count++;
+            RetValue = qTrue;
+        }
+    }
+    return RetValue;
+}
+/*=========================================================*/
+/*qBool_t qTree_Remove( qTree_t * const tree, void * const node )
+
+Remove a node from the tree.
+
+Parameters:
+
+    - tree : Pointer to the tree.
+    - node : A pointer to the node to be removed.
+
+Return value:
+
+    qTrue on success. qFalse if the node does not belong to the tree.
+*/
+qBool_t qTree_Remove( qTree_t * const tree, void * const node ){
+    qBool_t RetValue = qFalse;
+    qTreeNode_t *z = (qTreeNode_t*)node;
+    qTreeNode_t *y, *x, *xParent;
+    qUINT8_t RemovedColor;
+
+    if( ( NULL != tree ) && ( NULL != z ) ){
+        if( tree == z->__qTreeContainer ){
+            RemovedColor = z->__qTreeColor;
+            if( NULL == z->__qTreeLeft ){
+                x = z->__qTreeRight;
+                xParent = z->__qTreeParent;
+                qTree_Transplant( tree, z, x );
+            }
+            else if( NULL == z->__qTreeRight ){
+                x = z->__qTreeLeft;
+                xParent = z->__qTreeParent;
+                qTree_Transplant( tree, z, x );
+            }
+            else{ /*two children: the successor takes the place of the node*/
+                y = qTree_Leftmost( z->__qTreeRight );
+                RemovedColor = y->__qTreeColor;
+                x = y->__qTreeRight;
+                if( z == y->__qTreeParent ){
+                    xParent = y;
+                }
+                else{
+                    xParent = y->__qTreeParent;
+                    qTree_Transplant( tree, y, x );
+                    y->__qTreeRight = z->__qTreeRight;
+                    y->__qTreeRight->__qTreeParent = y;
+                }
+                qTree_Transplant( tree, z, y );
+                y->__qTreeLeft = z->__qTreeLeft;
+                y->__qTreeLeft->__qTreeParent = y;
+                y->__qTreeColor = z->__qTreeColor;
+            }
+            if( QTREE_BLACK == RemovedColor ){
+                qTree_RemoveFixup( tree, x, xParent );
+            }
+            z->__qTreeLeft = NULL;
+            z->__qTreeRight = NULL;
+            z->__qTreeParent = NULL;
+            z->__qTreeContainer = NULL;
+            tree->qPrivate.Count--;
+            RetValue = qTrue;
+        }
+    }
+    return RetValue;
+}
+/*=========================================================*/
+/*void* qTree_LowerBound( const qTree_t * const tree, const void *key )
+
+Find the first node that does not go before <key>.
+
+Parameters:
+
+    - tree : Pointer to the tree.
+    - key : A node (usually a temporary one) with the key fields filled.
+            It is only passed to the compare function.
+
+Return value:
+
+    A pointer to the node. NULL if all the nodes go before <key>.
+*/
+void* qTree_LowerBound( const qTree_t * const tree, const void *key ){
+    qTreeNode_t *RetValue = NULL;
+    qTreeNode_t *iNode;
+
+    if( ( NULL != tree ) && ( NULL != key ) ){
+        iNode = tree->qPrivate.Root;
+        while( NULL != iNode ){
+            if( tree->qPrivate.CompareFcn( iNode, key ) < 0 ){
+                iNode = iNode->__qTreeRight;
+            }
+            else{
+                RetValue = iNode;
+                iNode = iNode->__qTreeLeft;
+            }
+        }
+    }
+    return RetValue;
+}
+/*=========================================================*/
+/*void* qTree_UpperBound( const qTree_t * const tree, const void *key )
+
+Find the first node that goes after <key>.
+
+Parameters:
+
+    - tree : Pointer to the tree.
+    - key : A node (usually a temporary one) with the key fields filled.
+            It is only passed to the compare function.
+
+Return value:
+
+    A pointer to the node. NULL if no node goes after <key>.
+*/
+void* qTree_UpperBound( const qTree_t * const tree, const void *key ){
+    qTreeNode_t *RetValue = NULL;
+    qTreeNode_t *iNode;
+
+    if( ( NULL != tree ) && ( NULL != key ) ){
+        iNode = tree->qPrivate.Root;
+        while( NULL != iNode ){
+            if( tree->qPrivate.CompareFcn( iNode, key ) <= 0 ){
+                iNode = iNode->__qTreeRight;
+            }
+            else{
+                RetValue = iNode;
+                iNode = iNode->__qTreeLeft;
+            }
+        }
+    }
+    return RetValue;
+}
+/*=========================================================*/
+/*void* qTree_Find( const qTree_t * const tree, const void *key )
+
+Find the first node equivalent to <key>.
+
+Parameters:
+
+    - tree : Pointer to the tree.
+    - key : A node (usually a temporary one) with the key fields filled.
+            It is only passed to the compare function.
+
+Return value:
+
+    A pointer to the node. NULL if there is no node equivalent to <key>.
+*/
+void* qTree_Find( const qTree_t * const tree, const void *key ){
+    void *RetValue = qTree_LowerBound( tree, key );
+
+    if( NULL != RetValue ){
+        if( 0 != tree->qPrivate.CompareFcn( RetValue, key ) ){
+            RetValue = NULL;
+        }
+    }
+    return RetValue;
+}
+/*=========================================================*/
+/*void* qTree_Min( const qTree_t * const tree )
+
+Returns the first node of the tree or NULL if the tree is empty.
+*/
+void* qTree_Min( const qTree_t * const tree ){
+    return ( NULL != tree )? qTree_Leftmost( tree->qPrivate.Root ) : NULL;
+}
+/*=========================================================*/
+/*void* qTree_Max( const qTree_t * const tree )
+
+Returns the last node of the tree or NULL if the tree is empty.
+*/
+void* qTree_Max( const qTree_t * const tree ){
+    return ( NULL != tree )? qTree_Rightmost( tree->qPrivate.Root ) : NULL;
+}
+/*=========================================================*/
+/*void* qTree_Next( const void * const node )
+
+Returns the node that follows <node> in the tree order (successor) or
+NULL if <node> is the last one.
+*/
+void* qTree_Next( const void * const node ){
+    qTreeNode_t *RetValue = NULL;
+    const qTreeNode_t *iNode = (const qTreeNode_t*)node;
+
+    if( NULL != iNode ){
+        if( NULL != iNode->__qTreeRight ){
+            RetValue = qTree_Leftmost( iNode->__qTreeRight );
+        }
+        else{
+            RetValue = iNode->__qTreeParent;
+            while( ( NULL != RetValue ) && ( iNode == RetValue->__qTreeRight ) ){ /*go up until coming from a left child*/
+                iNode = RetValue;
+                RetValue = RetValue->__qTreeParent;
+            }
+        }
+    }
+    return RetValue;
+}
+/*=========================================================*/
+/*void* qTree_Prev( const void * const node )
+
+Returns the node that precedes <node> in the tree order (predecessor) or
+NULL if <node> is the first one.
+*/
+void* qTree_Prev( const void * const node ){
+    qTreeNode_t *RetValue = NULL;
+    const qTreeNode_t *iNode = (const qTreeNode_t*)node;
+
+    if( NULL != iNode ){
+        if( NULL != iNode->__qTreeLeft ){
+            RetValue = qTree_Rightmost( iNode->__qTreeLeft );
+        }
+        else{
+            RetValue = iNode->__qTreeParent;
+            while( ( NULL != RetValue ) && ( iNode == RetValue->__qTreeLeft ) ){
+                iNode = RetValue;
+                RetValue = RetValue->__qTreeParent;
+            }
+        }
+    }
+    return RetValue;
+}
+/*=========================================================*/
+/*size_t qTree_Count( const qTree_t * const tree )
+
+Returns the number of nodes in the tree.
+*/
+size_t qTree_Count( const qTree_t * const tree ){
+    return ( NULL != tree )? tree->qPrivate.Count : 0u;
+}
+/*=========================================================*/
+/*qBool_t qTree_IsEmpty( const qTree_t * const tree )
+
+Returns qTrue if the tree is empty, otherwise returns qFalse.
+*/
+qBool_t qTree_IsEmpty( const qTree_t * const tree ){
+    return ( ( NULL == tree ) || ( NULL == tree->qPrivate.Root ) )? qTrue : qFalse;
+}
+/*=========================================================*/
+/*qBool_t qTree_ForEach( qTree_t * const tree, const qListNodeFcn_t Fcn, void *arg )
+
+Operate on each node of the tree in order. The current node can be
+removed from <Fcn>.
+
+Parameters:
+
+    - tree : Pointer to the tree.
+    - Fcn : The function to perform over the node.
+            Should have this prototype:
+            qBool_t Function( void* Node, void *arg, qList_WalkStage_t stage )
+
+            If <Function> returns qTrue, the walk through loop
+            will be terminated.
+
+    - arg : Argument passed to <Fcn>
+
+Return value:
+
+    qTrue if the walk through was early terminated, otherwise returns qFalse.
+*/
+qBool_t qTree_ForEach( qTree_t * const tree, const qListNodeFcn_t Fcn, void *arg ){
+    qBool_t RetValue = qFalse;
+    void *iNode, *Next;
+
+    if( ( NULL != tree ) && ( NULL != Fcn ) ){
+        RetValue = Fcn( NULL, arg, qList_WalkInit );
+        if( qFalse == RetValue ){
+            for( iNode = qTree_Min( tree ) ; NULL != iNode ; iNode = Next ){
+                Next = qTree_Next( iNode ); /*the successor is saved, so the node can be removed*/
+                RetValue = Fcn( iNode, arg, qList_WalkThrough );
+                if( RetValue ){
+                    break;
+                }
+            }
+            if( qFalse == RetValue ){
+                RetValue = Fcn( NULL, arg, qList_WalkEnd );
+            }
+        }
+    }
+    return RetValue;
+}
+/*=========================================================*/
@@ -18,6 +18,7 @@ embedded application
 #include <ctype.h>
 #include <termios.h>
 #include <math.h>
+#include <sched.h>
 #include <assert.h>
 
 #include "QuarkTS.h"
@@ -253,6 +254,1514 @@ qBool_t comparator(const void *p, const void *q) {
     return qFalse; 
 } 
 
+/*============================================================================*/
+/*
+Randomized checks and micro-benchmarks of the containers and buffers. They run
+before the scheduler starts, a failed check aborts the program.
+*/
+#define TEST_NODES      ( 20000 )
+
+typedef struct{
+    qNode_MinimalFields;
+    int key;
+    int seq;
+}testnode_t;
+
+typedef struct{
+    qHashNode_MinimalFields;
+    qUINT32_t key;
+    int visits;
+}testhnode_t;
+
+typedef struct{
+    qTreeNode_MinimalFields;
+    int key;
+    int seq;
+}testtnode_t;
+
+static testnode_t TestNodes[ TEST_NODES ];
+static testhnode_t TestHNodes[ 512 ];
+static testtnode_t TestTNodes[ TEST_NODES ];
+static void *TestBuckets8[ 8 ], *TestBuckets64[ 64 ], *TestBuckets512[ 512 ];
+static qHashMap_t TestMap;
+
+double test_elapsed_us( const struct timespec *start ){
+    struct timespec now;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return ( (double)( now.tv_sec - start->tv_sec )*1e6 ) + ( (double)( now.tv_nsec - start->tv_nsec )/1e3 );
+}
+/*============================================================================*/
+qBool_t test_listcompare( const void *p, const void *q ){
+    return ( ( (const testnode_t*)p )->key > ( (const testnode_t*)q )->key )? qTrue : qFalse;
+}
+/*============================================================================*/
+void test_listfill( qList_t *l, int n, int keyrange ){
+    int i;
+    qList_Initialize( l );
+    for( i = 0 ; i < n ; i++ ){
+        TestNodes[ i ].key = rand() % keyrange;
+        TestNodes[ i ].seq = i;
+        TestNodes[ i ].container = NULL;
+        assert( qTrue == qList_Insert( l, &TestNodes[ i ], qList_AtBack ) );
+    }
+}
+/*============================================================================*/
+void test_listbubblesort( qList_t * const list, qBool_t (*CompareFcn)(const void *n1, const void *n2) ){ /*the former qList_Sort, as a reference*/
+    size_t count, i, j, n;
+    qNode_t *current = NULL, *before, *after;
+
+    count = list->size;
+    if( count >= (size_t)2 ){
+        for( i = (size_t)1 ; i < count ; i++ ){
+            current = list->head;
+            n = count - i - (size_t)1;
+            for( j = (size_t)0 ; j <= n ; j++ ){
+                if( qTrue == CompareFcn( current, current->next ) ){ /*swap the adjacent nodes*/
+                    before = current->prev;
+                    after = current->next;
+                    if( NULL != before ){
+                        before->next = after;
+                    }
+                    else{
+                        list->head = after;
+                    }
+                    current->next = after->next;
+                    current->prev = after;
+                    if( NULL != after->next ){
+                        after->next->prev = current;
+                    }
+                    after->next = current;
+                    after->prev = before;
+                }
+                else{
+                    current = current->next;
+                }
+            }
+        }
+        while( NULL != current->next ){
+            current = current->next;
+        }
+        list->tail = current;
+    }
+}
+/*============================================================================*/
+void test_listsort( void ){
+    qList_t l;
+    testnode_t *iNode, *Prev;
+    qList_t ref;
+    struct timespec t;
+    double bubble, merge;
+    int round, n, i;
+    size_t count;
+
+    for( round = 0 ; round < 50 ; round++ ){ /*random lengths, including the empty and single-node lists*/
+        n = rand() % 300;
+        test_listfill( &l, n, 16 );
+        qList_Sort( &l, test_listcompare );
+        assert( (size_t)n == qList_Length( &l ) );
+        Prev = NULL;
+        count = 0u;
+        qList_Iterate( &l, testnode_t, iNode ){
+            assert( (void*)Prev == iNode->prev ); /*the back links are rebuilt*/
+            assert( (void*)&l == iNode->container );
+            if( NULL != Prev ){
+                assert( Prev->key <= iNode->key );
+                if( Prev->key == iNode->key ){
+                    assert( Prev->seq < iNode->seq ); /*stable*/
+                }
+            }
+            Prev = iNode;
+            count++;
+        }
+        assert( (size_t)n == count );
+        assert( (void*)Prev == qList_GetBack( &l ) );
+    }
+    for( n = 100 ; n <= 10000 ; n *= 10 ){ /*the merge sort against the former bubble sort, on the same input*/
+        test_listfill( &l, n, n );
+        qList_Initialize( &ref );
+        for( i = 0 ; i < n ; i++ ){
+            TestNodes[ n + i ] = TestNodes[ i ];
+            TestNodes[ n + i ].container = NULL;
+            assert( qTrue == qList_Insert( &ref, &TestNodes[ n + i ], qList_AtBack ) );
+        }
+        clock_gettime( CLOCK_MONOTONIC, &t );
+        test_listbubblesort( &ref, test_listcompare );
+        bubble = test_elapsed_us( &t );
+        clock_gettime( CLOCK_MONOTONIC, &t );
+        qList_Sort( &l, test_listcompare );
+        merge = test_elapsed_us( &t );
+        iNode = (testnode_t*)qList_GetFront( &l );
+        Prev = (testnode_t*)qList_GetFront( &ref );
+        for( i = 0 ; i < n ; i++ ){ /*both sorts are stable, so the results are the same*/
+            assert( ( iNode->key == Prev->key ) && ( iNode->seq == Prev->seq ) );
+            iNode = (testnode_t*)iNode->next;
+            Prev = (testnode_t*)Prev->next;
+        }
+        printf( "qList_Sort %5d nodes: %9.1f us (bubble sort: %9.1f us)\r\n", n, merge, bubble );
+    }
+}
+/*============================================================================*/
+qBool_t test_listsum( void *node, void *arg, qList_WalkStage_t stage ){
+    if( qList_WalkThrough == stage ){
+        *( (long*)arg ) += ( (testnode_t*)node )->key;
+    }
+    return qFalse;
+}
+/*============================================================================*/
+void test_listiterate( void ){
+    qList_t l, odd;
+    testnode_t *iNode, *Next;
+    struct timespec t;
+    long sum1 = 0, sum2 = 0;
+    int r;
+    size_t count = 0u;
+
+    test_listfill( &l, 10000, 1000 );
+    qList_Initialize( &odd );
+    (void)qList_ForEach( &l, test_listsum, &sum1, QLIST_FORWARD );
+    qList_IterateBackward( &l, testnode_t, iNode ){
+        sum2 += iNode->key;
+    }
+    assert( sum1 == sum2 );
+    clock_gettime( CLOCK_MONOTONIC, &t );
+    for( r = 0 ; r < 200 ; r++ ){
+        (void)qList_ForEach( &l, test_listsum, &sum1, QLIST_FORWARD );
+    }
+    printf( "qList_ForEach 10000 nodes: %9.1f us\r\n", test_elapsed_us( &t )/200.0 );
+    clock_gettime( CLOCK_MONOTONIC, &t );
+    for( r = 0 ; r < 200 ; r++ ){
+        qList_Iterate( &l, testnode_t, iNode ){
+            sum2 += iNode->key;
+        }
+    }
+    printf( "qList_Iterate 10000 nodes: %9.1f us\r\n", test_elapsed_us( &t )/200.0 );
+    assert( sum1 == sum2 );
+
+    qList_IterateSafe( &l, testnode_t, iNode, Next ){ /*move the odd keys to another list*/
+        if( iNode->key & 1 ){
+            assert( qTrue == qList_RemoveItself( iNode ) );
+            assert( qTrue == qList_Insert( &odd, iNode, qList_AtBack ) );
+        }
+    }
+    qList_IterateBackwardSafe( &l, testnode_t, iNode, Next ){
+        assert( 0 == ( iNode->key & 1 ) );
+        count++;
+    }
+    qList_Iterate( &odd, testnode_t, iNode ){
+        assert( 1 == ( iNode->key & 1 ) );
+        count++;
+    }
+    assert( 10000u == count );
+    assert( 10000u == qList_Length( &l ) + qList_Length( &odd ) );
+}
+/*============================================================================*/
+void test_listverify( qList_t *l, const int *model, int n ){
+    testnode_t *iNode, *Prev = NULL;
+    int i = 0;
+
+    assert( (size_t)n == qList_Length( l ) );
+    qList_Iterate( l, testnode_t, iNode ){
+        assert( ( i < n ) && ( model[ i ] == iNode->seq ) );
+        assert( ( (void*)Prev == iNode->prev ) && ( (void*)l == iNode->container ) );
+        Prev = iNode;
+        i++;
+    }
+    assert( ( i == n ) && ( (void*)Prev == qList_GetBack( l ) ) );
+}
+/*============================================================================*/
+void test_listsplice( void ){
+    static int model[ 2 ][ 400 ], tmp[ 400 ];
+    qList_t l[ 2 ];
+    int n[ 2 ], op, s, d, a, b, at, k, i;
+
+    test_listfill( &l[ 0 ], 200, 1 );
+    qList_Initialize( &l[ 1 ] );
+    for( i = 0 ; i < 200 ; i++ ){
+        model[ 0 ][ i ] = i;
+    }
+    n[ 0 ] = 200;
+    n[ 1 ] = 0;
+    for( op = 0 ; op < 5000 ; op++ ){
+        s = rand() & 1;
+        d = s ^ 1;
+        if( 0 == n[ s ] ){
+            continue;
+        }
+        a = rand() % n[ s ];
+        b = rand() % n[ s ];
+        at = ( n[ d ] > 0 )? ( rand() % ( n[ d ] + 1 ) ) - 1 : -1; /*insert after this index, -1 for the front*/
+        switch( rand() % 4 ){
+            case 0: case 1: /*move the range [a,b] after <at>, or fail if <b> precedes <a>*/
+                assert( ( a <= b ) == qList_SpliceRange( &l[ d ], ( at < 0 )? NULL : &TestNodes[ model[ d ][ at ] ], &l[ s ], &TestNodes[ model[ s ][ a ] ], &TestNodes[ model[ s ][ b ] ] ) );
+                if( a > b ){
+                    break;
+                }
+                k = b - a + 1;
+                (void)memcpy( tmp, &model[ s ][ a ], (size_t)k*sizeof(int) );
+                (void)memmove( &model[ s ][ a ], &model[ s ][ b + 1 ], (size_t)( n[ s ] - b - 1 )*sizeof(int) );
+                (void)memmove( &model[ d ][ at + 1 + k ], &model[ d ][ at + 1 ], (size_t)( n[ d ] - at - 1 )*sizeof(int) );
+                (void)memcpy( &model[ d ][ at + 1 ], tmp, (size_t)k*sizeof(int) );
+                n[ s ] -= k;
+                n[ d ] += k;
+                break;
+            case 2: /*the nodes from <a> to the end go to the back of the other list*/
+                assert( qTrue == qList_SplitAt( &l[ s ], &TestNodes[ model[ s ][ a ] ], &l[ d ] ) );
+                k = n[ s ] - a;
+                (void)memcpy( &model[ d ][ n[ d ] ], &model[ s ][ a ], (size_t)k*sizeof(int) );
+                n[ s ] -= k;
+                n[ d ] += k;
+                break;
+            default: /*the whole list goes after <at>*/
+                assert( qTrue == qList_Move( &l[ d ], &l[ s ], ( at < 0 )? qList_AtFront : (qListPosition_t)at ) );
+                k = n[ s ];
+                (void)memmove( &model[ d ][ at + 1 + k ], &model[ d ][ at + 1 ], (size_t)( n[ d ] - at - 1 )*sizeof(int) );
+                (void)memcpy( &model[ d ][ at + 1 ], model[ s ], (size_t)k*sizeof(int) );
+                n[ s ] = 0;
+                n[ d ] += k;
+                break;
+        }
+        test_listverify( &l[ 0 ], model[ 0 ], n[ 0 ] );
+        test_listverify( &l[ 1 ], model[ 1 ], n[ 1 ] );
+    }
+}
+/*============================================================================*/
+void test_listinsertsorted( void ){
+    qList_t l;
+    testnode_t *iNode, *Prev = NULL;
+    int i, count = 0, histogram[ 16 ] = { 0 };
+
+    qList_Initialize( &l );
+    for( i = 0 ; i < 500 ; i++ ){
+        TestNodes[ i ].key = ( i < 100 )? ( i/7 ) : ( rand() % 16 ); /*in order first, then random*/
+        TestNodes[ i ].seq = i;
+        TestNodes[ i ].container = NULL;
+        histogram[ TestNodes[ i ].key ]++;
+        assert( qTrue == qList_InsertSorted( &l, &TestNodes[ i ], test_listcompare ) );
+    }
+    assert( qFalse == qList_InsertSorted( &l, &TestNodes[ 0 ], test_listcompare ) ); /*already a member*/
+    qList_Iterate( &l, testnode_t, iNode ){ /*the order and the FIFO order of the equal keys, checked by a linear scan*/
+        if( NULL != Prev ){
+            assert( ( Prev->key < iNode->key ) || ( ( Prev->key == iNode->key ) && ( Prev->seq < iNode->seq ) ) );
+        }
+        histogram[ iNode->key ]--;
+        Prev = iNode;
+        count++;
+    }
+    assert( ( 500 == count ) && ( (void*)Prev == qList_GetBack( &l ) ) );
+    for( i = 0 ; i < 16 ; i++ ){
+        assert( 0 == histogram[ i ] );
+    }
+}
+/*============================================================================*/
+#if ( Q_LIST_INDEX_LEVELS > 0 )
+typedef struct{
+    qListIndex_NodeFields;
+    int key;
+    int seq;
+}testinode_t;
+
+static testinode_t TestINodes[ 2000 ];
+/*============================================================================*/
+qBool_t test_listindexcompare( const void *p, const void *q ){
+    return ( ( (const testinode_t*)p )->key > ( (const testinode_t*)q )->key )? qTrue : qFalse;
+}
+/*============================================================================*/
+void test_listindexverify( const qListIndex_t *index, const qList_t *l ){
+    testinode_t *iNode, *Prev = NULL;
+    size_t rank = 0u;
+    qUINT8_t level;
+
+    for( iNode = (testinode_t*)l->head ; NULL != iNode ; iNode = (testinode_t*)iNode->next ){ /*linear scan*/
+        if( NULL != Prev ){
+            assert( ( Prev->key < iNode->key ) || ( ( Prev->key == iNode->key ) && ( Prev->seq < iNode->seq ) ) );
+        }
+        assert( (void*)iNode == qListIndex_GetAt( index, rank ) ); /*the rank lookup agrees with the scan*/
+        Prev = iNode;
+        rank++;
+    }
+    assert( ( rank == qList_Length( l ) ) && ( NULL == qListIndex_GetAt( index, rank ) ) );
+    for( level = index->qPrivate.Height ; level < (qUINT8_t)Q_LIST_INDEX_LEVELS ; level++ ){ /*the levels above the height are empty*/
+        assert( NULL == index->qPrivate.Header.__qIndexForward[ level ] );
+    }
+}
+/*============================================================================*/
+void test_listindex( void ){
+    qList_t l;
+    qListIndex_t index;
+    testinode_t *node;
+    int i, next = 0, op;
+
+    qList_Initialize( &l );
+    for( ; next < 300 ; next++ ){ /*an unsorted list, sorted and indexed by the setup*/
+        TestINodes[ next ].key = rand() % 64;
+        TestINodes[ next ].seq = next;
+        TestINodes[ next ].container = NULL;
+        assert( qTrue == qList_Insert( &l, &TestINodes[ next ], qList_AtBack ) );
+    }
+    assert( qTrue == qListIndex_Setup( &index, &l, test_listindexcompare ) );
+    test_listindexverify( &index, &l );
+    for( op = 0 ; op < 4000 ; op++ ){
+        switch( rand() % 4 ){
+            case 0: case 1:
+                if( next < 2000 ){
+                    TestINodes[ next ].key = rand() % 64;
+                    TestINodes[ next ].seq = next;
+                    TestINodes[ next ].container = NULL;
+                    assert( qTrue == qListIndex_Insert( &index, &TestINodes[ next ] ) );
+                    assert( qFalse == qListIndex_Insert( &index, &TestINodes[ next ] ) ); /*already a member*/
+                    next++;
+                }
+                break;
+            case 2:
+                if( qList_Length( &l ) > 0u ){
+                    node = (testinode_t*)qListIndex_RemoveAt( &index, (size_t)rand() % qList_Length( &l ) );
+                    assert( ( NULL != node ) && ( NULL == node->container ) );
+                }
+                break;
+            default:
+                i = rand() % next;
+                if( NULL != TestINodes[ i ].container ){
+                    assert( qTrue == qListIndex_Remove( &index, &TestINodes[ i ] ) );
+                }
+                assert( qFalse == qListIndex_Remove( &index, &TestINodes[ i ] ) );
+                break;
+        }
+        if( 0 == ( op % 50 ) ){
+            test_listindexverify( &index, &l );
+        }
+    }
+    test_listindexverify( &index, &l );
+    do{ /*the height drops back to zero*/
+        node = (testinode_t*)qListIndex_RemoveAt( &index, 0u );
+    }while( NULL != node );
+    assert( ( 0u == qList_Length( &l ) ) && ( 0u == index.qPrivate.Height ) );
+    test_listindexverify( &index, &l );
+}
+#endif
+/*============================================================================*/
+qBool_t test_hashremoveeven( void *node, void *arg, qList_WalkStage_t stage ){
+    testhnode_t *xNode = (testhnode_t*)node;
+    qUINT32_t key;
+    (void)arg;
+    if( qList_WalkThrough == stage ){
+        xNode->visits++;
+        key = xNode->key ^ 1u;
+        (void)qHashMap_Find( &TestMap, &key ); /*lookups are allowed in the walk*/
+        if( 0u == ( xNode->key & 1u ) ){
+            assert( qTrue == qHashMap_Remove( &TestMap, xNode ) );
+        }
+    }
+    return qFalse;
+}
+/*============================================================================*/
+void test_hashmap( void ){
+    static char present[ 512 ];
+    void **Tables[ 3 ];
+    size_t Sizes[ 3 ], count = 0u;
+    qUINT32_t key;
+    struct timespec t;
+    int i, op, k, next = 1;
+    volatile void *found = NULL;
+
+    Tables[ 0 ] = TestBuckets8;     Sizes[ 0 ] = 8u;
+    Tables[ 1 ] = TestBuckets64;    Sizes[ 1 ] = 64u;
+    Tables[ 2 ] = TestBuckets512;   Sizes[ 2 ] = 512u;
+    for( i = 0 ; i < 512 ; i++ ){
+        TestHNodes[ i ].key = (qUINT32_t)i*2654435761uL;
+        TestHNodes[ i ].__qHashContainer = NULL;
+        present[ i ] = 0;
+    }
+    assert( qTrue == qHashMap_Setup( &TestMap, Tables[ 0 ], Sizes[ 0 ], qHashMap_U32Hash, qHashMap_U32Equal ) );
+    for( op = 0 ; op < 50000 ; op++ ){ /*random operations checked against a presence table*/
+        k = rand() % 512;
+        switch( rand() % 4 ){
+            case 0: case 1:
+                assert( ( 0 == present[ k ] ) == qHashMap_Insert( &TestMap, &TestHNodes[ k ], &TestHNodes[ k ].key ) );
+                count += ( 0 == present[ k ] )? 1u : 0u;
+                present[ k ] = 1;
+                break;
+            case 2:
+                assert( ( 1 == present[ k ] ) == ( NULL != qHashMap_RemoveKey( &TestMap, &TestHNodes[ k ].key ) ) );
+                count -= ( 1 == present[ k ] )? 1u : 0u;
+                present[ k ] = 0;
+                break;
+            default:
+                assert( ( ( 1 == present[ k ] )? (void*)&TestHNodes[ k ] : NULL ) == qHashMap_Find( &TestMap, &TestHNodes[ k ].key ) );
+                break;
+        }
+        assert( count == qHashMap_Count( &TestMap ) );
+        if( ( 0 == ( op % 997 ) ) && ( qFalse == qHashMap_IsResizing( &TestMap ) ) ){ /*move to another bucket array*/
+            assert( qTrue == qHashMap_Resize( &TestMap, Tables[ next ], Sizes[ next ] ) );
+            next = ( next + 1 ) % 3;
+        }
+    }
+    assert( qTrue == qHashMap_Rehash( &TestMap, 0u ) );
+
+    /*remove nodes from a walk while a resize is in progress*/
+    assert( qTrue == qHashMap_Setup( &TestMap, TestBuckets8, 8u, qHashMap_U32Hash, qHashMap_U32Equal ) );
+    for( i = 0 ; i < 40 ; i++ ){
+        TestHNodes[ i ].key = (qUINT32_t)i;
+        TestHNodes[ i ].visits = 0;
+        TestHNodes[ i ].__qHashContainer = NULL;
+        assert( qTrue == qHashMap_Insert( &TestMap, &TestHNodes[ i ], &TestHNodes[ i ].key ) );
+    }
+    assert( qTrue == qHashMap_Resize( &TestMap, TestBuckets64, 64u ) );
+    assert( qTrue == qHashMap_IsResizing( &TestMap ) );
+    (void)qHashMap_ForEach( &TestMap, test_hashremoveeven, NULL );
+    for( i = 0 ; i < 40 ; i++ ){
+        assert( 1 == TestHNodes[ i ].visits );
+        key = (qUINT32_t)i;
+        assert( ( 0 == ( i & 1 ) ) == ( NULL == qHashMap_Find( &TestMap, &key ) ) );
+    }
+    assert( 20u == qHashMap_Count( &TestMap ) );
+
+    assert( qTrue == qHashMap_Setup( &TestMap, TestBuckets512, 512u, qHashMap_U32Hash, qHashMap_U32Equal ) );
+    for( i = 0 ; i < 512 ; i++ ){
+        TestHNodes[ i ].key = (qUINT32_t)i*2654435761uL;
+        TestHNodes[ i ].__qHashContainer = NULL;
+        (void)qHashMap_Insert( &TestMap, &TestHNodes[ i ], &TestHNodes[ i ].key );
+    }
+    clock_gettime( CLOCK_MONOTONIC, &t );
+    for( op = 0 ; op < 1000000 ; op++ ){
+        found = qHashMap_Find( &TestMap, &TestHNodes[ op & 511 ].key );
+    }
+    (void)found;
+    printf( "qHashMap_Find 512 nodes: %9.1f ns\r\n", test_elapsed_us( &t )*1e3/1e6 );
+}
+/*============================================================================*/
+int test_treecompare( const void *n1, const void *n2 ){
+    return ( (const testtnode_t*)n1 )->key - ( (const testtnode_t*)n2 )->key;
+}
+/*============================================================================*/
+int test_treecheck( const qTree_t *tree, const qTreeNode_t *node, const qTreeNode_t *parent ){ /*returns the black height*/
+    int lh, rh;
+    if( NULL == node ){
+        return 1;
+    }
+    assert( parent == node->__qTreeParent );
+    assert( (const void*)tree == node->__qTreeContainer );
+    if( 0u == node->__qTreeColor ){ /*a red node can't have red children*/
+        assert( ( NULL == node->__qTreeLeft ) || ( 1u == node->__qTreeLeft->__qTreeColor ) );
+        assert( ( NULL == node->__qTreeRight ) || ( 1u == node->__qTreeRight->__qTreeColor ) );
+    }
+    lh = test_treecheck( tree, node->__qTreeLeft, node );
+    rh = test_treecheck( tree, node->__qTreeRight, node );
+    assert( lh == rh );
+    return lh + (int)node->__qTreeColor;
+}
+/*============================================================================*/
+void test_treeverify( const qTree_t *tree, size_t expected ){
+    const testtnode_t *Root, *iNode, *Prev = NULL;
+    size_t count = 0u;
+
+    Root = (const testtnode_t*)qTree_Min( tree );
+    while( ( NULL != Root ) && ( NULL != Root->__qTreeParent ) ){
+        Root = (const testtnode_t*)Root->__qTreeParent;
+    }
+    if( NULL != Root ){
+        assert( 1u == Root->__qTreeColor );
+        (void)test_treecheck( tree, (const qTreeNode_t*)Root, NULL );
+    }
+    qTree_Iterate( tree, const testtnode_t, iNode ){ /*in order, equivalent nodes keep the insertion order*/
+        if( NULL != Prev ){
+            assert( ( Prev->key < iNode->key ) || ( ( Prev->key == iNode->key ) && ( Prev->seq < iNode->seq ) ) );
+            assert( (const void*)Prev == qTree_Prev( iNode ) );
+        }
+        Prev = iNode;
+        count++;
+    }
+    assert( (const void*)Prev == qTree_Max( tree ) );
+    assert( expected == count );
+    assert( expected == qTree_Count( tree ) );
+}
+/*============================================================================*/
+void test_tree( void ){
+    qTree_t tree;
+    qList_t l;
+    testtnode_t key, *Min;
+    testnode_t *First;
+    struct timespec t;
+    int i, k, n = 0;
+
+    assert( qTrue == qTree_Initialize( &tree, test_treecompare ) );
+    for( i = 0 ; i < TEST_NODES ; i++ ){
+        TestTNodes[ i ].key = rand() % 5000; /*with duplicates*/
+        TestTNodes[ i ].seq = i;
+        TestTNodes[ i ].__qTreeContainer = NULL;
+        assert( qTrue == qTree_Insert( &tree, &TestTNodes[ i ] ) );
+        if( 0 == ( i % 4999 ) ){
+            test_treeverify( &tree, (size_t)i + 1u );
+        }
+    }
+    test_treeverify( &tree, TEST_NODES );
+    for( i = 0 ; i < TEST_NODES/2 ; i++ ){ /*remove half of the nodes in random order*/
+        k = rand() % TEST_NODES;
+        if( NULL != TestTNodes[ k ].__qTreeContainer ){
+            assert( qTrue == qTree_Remove( &tree, &TestTNodes[ k ] ) );
+            assert( qFalse == qTree_Remove( &tree, &TestTNodes[ k ] ) );
+            n++;
+        }
+    }
+    test_treeverify( &tree, (size_t)( TEST_NODES - n ) );
+    for( k = 0 ; k < 5000 ; k += 7 ){ /*the lower bound is the first node not less than the key*/
+        key.key = k;
+        Min = (testtnode_t*)qTree_LowerBound( &tree, &key );
+        assert( ( NULL == Min ) || ( Min->key >= k ) );
+        assert( ( NULL == Min ) || ( NULL == qTree_Prev( Min ) ) || ( ( (testtnode_t*)qTree_Prev( Min ) )->key < k ) );
+    }
+
+    assert( qTrue == qTree_Initialize( &tree, test_treecompare ) ); /*pop-min/re-insert with 1000 pending deadlines*/
+    for( i = 0 ; i < 1000 ; i++ ){
+        TestTNodes[ i ].key = rand() % 100000;
+        TestTNodes[ i ].seq = i;
+        TestTNodes[ i ].__qTreeContainer = NULL;
+        (void)qTree_Insert( &tree, &TestTNodes[ i ] );
+    }
+    clock_gettime( CLOCK_MONOTONIC, &t );
+    for( i = 0 ; i < 100000 ; i++ ){
+        Min = (testtnode_t*)qTree_Min( &tree );
+        (void)qTree_Remove( &tree, Min );
+        Min->key += rand() % 100000;
+        Min->seq = 1000 + i;
+        (void)qTree_Insert( &tree, Min );
+    }
+    printf( "qTree pop-min/insert 1000 nodes: %9.1f ns\r\n", test_elapsed_us( &t )*1e3/100000.0 );
+    test_treeverify( &tree, 1000u );
+    test_listfill( &l, 1000, 100000 );
+    qList_Sort( &l, test_listcompare );
+    clock_gettime( CLOCK_MONOTONIC, &t );
+    for( i = 0 ; i < 1000 ; i++ ){
+        First = (testnode_t*)qList_Remove( &l, NULL, qList_AtFront );
+        First->key += rand() % 100000;
+        (void)qList_Insert( &l, First, qList_AtBack );
+        qList_Sort( &l, test_listcompare );
+    }
+    printf( "qList pop-front/append/sort 1000 nodes: %9.1f ns\r\n", test_elapsed_us( &t )*1e3/1000.0 );
+}
+/*============================================================================*/
+void test_queuebulk( void ){
+    qQueue_t q;
+    static qUINT16_t area[ 13 ], src[ 64 ], dst[ 64 ];
+    qUINT16_t sent = 0u, received = 0u;
+    struct timespec t;
+    size_t n, i, k;
+    int op;
+
+    assert( qTrue == qQueueCreate( &q, area, sizeof(qUINT16_t), 13u ) ); /*not a power of two, the copies wrap anywhere*/
+    for( op = 0 ; op < 20000 ; op++ ){
+        n = (size_t)( rand() % 20 );
+        if( rand() & 1 ){
+            for( i = 0u ; i < n ; i++ ){
+                src[ i ] = (qUINT16_t)( sent + i );
+            }
+            k = qQueueSendN( &q, src, n );
+            assert( k <= n );
+            assert( ( k == n ) || ( qTrue == qQueueIsFull( &q ) ) );
+            sent = (qUINT16_t)( sent + k );
+        }
+        else{
+            k = qQueueReceiveN( &q, dst, n );
+            assert( ( k == n ) || ( qTrue == qQueueIsEmpty( &q ) ) );
+            for( i = 0u ; i < k ; i++ ){
+                assert( dst[ i ] == received++ );
+            }
+        }
+        assert( (size_t)(qUINT16_t)( sent - received ) == qQueueCount( &q ) );
+    }
+
+    assert( qTrue == qQueueCreate( &q, src, sizeof(qUINT16_t), 64u ) );
+    clock_gettime( CLOCK_MONOTONIC, &t );
+    for( op = 0 ; op < 20000 ; op++ ){
+        for( i = 0u ; i < 64u ; i++ ){
+            (void)qQueueSendToBack( &q, &dst[ i ] );
+        }
+        for( i = 0u ; i < 64u ; i++ ){
+            (void)qQueueReceive( &q, &dst[ i ] );
+        }
+    }
+    printf( "qQueueSend/qQueueReceive: %9.2f ns/item\r\n", test_elapsed_us( &t )*1e3/( 20000.0*64.0 ) );
+    clock_gettime( CLOCK_MONOTONIC, &t );
+    for( op = 0 ; op < 20000 ; op++ ){
+        assert( 64u == qQueueSendN( &q, dst, 64u ) );
+        assert( 64u == qQueueReceiveN( &q, dst, 64u ) );
+    }
+    printf( "qQueueSendN/qQueueReceiveN: %9.2f ns/item\r\n", test_elapsed_us( &t )*1e3/( 20000.0*64.0 ) );
+}
+/*============================================================================*/
+void test_bsbuffer( void ){
+    qBSBuffer_t b;
+    static qUINT8_t area[ 100 ], tmp[ 80 ];
+    qUINT8_t in = 0u, out = 0u, c;
+    struct timespec t;
+    size_t n, i, count = 0u;
+    int op;
+
+    qBSBuffer_Init( &b, area, sizeof(area) ); /*rounded down to 64*/
+    assert( 64u == b.length );
+    for( op = 0 ; op < 50000 ; op++ ){ /*random operations checked against a running sequence*/
+        n = (size_t)( rand() % 80 );
+        switch( rand() % 4 ){
+            case 0:
+                if( qTrue == qBSBuffer_Put( &b, in ) ){
+                    in++;
+                    count++;
+                }
+                else{
+                    assert( 64u == count );
+                }
+                break;
+            case 1:
+                if( qTrue == qBSBuffer_Get( &b, &c ) ){
+                    assert( c == out++ );
+                    count--;
+                }
+                else{
+                    assert( 0u == count );
+                }
+                break;
+            case 2:
+                for( i = 0u ; i < n ; i++ ){
+                    tmp[ i ] = (qUINT8_t)( in + i );
+                }
+                n = qBSBuffer_WriteUpTo( &b, tmp, n );
+                in = (qUINT8_t)( in + n );
+                count += n;
+                break;
+            default:
+                n = qBSBuffer_ReadUpTo( &b, tmp, n );
+                for( i = 0u ; i < n ; i++ ){
+                    assert( tmp[ i ] == out++ );
+                }
+                count -= n;
+                break;
+        }
+        assert( count <= 64u );
+        assert( count == qBSBuffer_Count( &b ) );
+        assert( ( 64u == count ) == qBSBuffer_IsFull( &b ) );
+    }
+
+    qBSBuffer_Init( &b, area, 64u );
+    clock_gettime( CLOCK_MONOTONIC, &t );
+    for( op = 0 ; op < 20000 ; op++ ){
+        for( i = 0u ; i < 48u ; i++ ){
+            (void)qBSBuffer_Put( &b, tmp[ i ] );
+        }
+        for( i = 0u ; i < 48u ; i++ ){
+            (void)qBSBuffer_Get( &b, &tmp[ i ] );
+        }
+    }
+    printf( "qBSBuffer Put/Get: %9.2f ns/byte\r\n", test_elapsed_us( &t )*1e3/( 20000.0*48.0 ) );
+}
+/*============================================================================*/
+void test_bsbufferspan( void ){
+    qBSBuffer_t b;
+    static qUINT8_t area[ 16 ];
+    qUINT8_t in = 0u, out = 0u, *span;
+    size_t size, n, i, count = 0u;
+    int op;
+
+    qBSBuffer_Init( &b, area, sizeof(area) );
+    assert( ( NULL == qBSBuffer_GetReadSpan( &b, &size ) ) && ( 0u == size ) );
+    assert( qFalse == qBSBuffer_ConsumeRead( &b, 1u ) );
+    b.head = b.tail = (qIndex_t)-3; /*the indexes wrap around too*/
+    span = (qUINT8_t*)qBSBuffer_GetWriteSpan( &b, &size );
+    assert( ( span == &area[ 13 ] ) && ( 3u == size ) ); /*only the part before the end of the buffer*/
+    assert( qFalse == qBSBuffer_CommitWrite( &b, 17u ) );
+    span[ 0 ] = 0u;
+    span[ 1 ] = 1u;
+    span[ 2 ] = 2u;
+    assert( qTrue == qBSBuffer_CommitWrite( &b, 3u ) );
+    span = (qUINT8_t*)qBSBuffer_GetWriteSpan( &b, &size );
+    assert( ( span == &area[ 0 ] ) && ( 13u == size ) ); /*the rest, after the wrap*/
+    for( i = 0u ; i < size ; i++ ){
+        span[ i ] = (qUINT8_t)( i + 3u );
+    }
+    assert( qTrue == qBSBuffer_CommitWrite( &b, size ) );
+    assert( ( qTrue == qBSBuffer_IsFull( &b ) ) && ( NULL == qBSBuffer_GetWriteSpan( &b, &size ) ) && ( 0u == size ) );
+    span = (qUINT8_t*)qBSBuffer_GetReadSpan( &b, &size );
+    assert( ( span == &area[ 13 ] ) && ( 3u == size ) && ( 2u == span[ 2 ] ) );
+    assert( qTrue == qBSBuffer_ConsumeRead( &b, 2u ) ); /*a partial consume*/
+    span = (qUINT8_t*)qBSBuffer_GetReadSpan( &b, &size );
+    assert( ( span == &area[ 15 ] ) && ( 1u == size ) && ( 2u == span[ 0 ] ) );
+    assert( qTrue == qBSBuffer_ConsumeRead( &b, 1u ) );
+    span = (qUINT8_t*)qBSBuffer_GetReadSpan( &b, &size );
+    assert( ( span == &area[ 0 ] ) && ( 13u == size ) && ( 3u == span[ 0 ] ) );
+    assert( qFalse == qBSBuffer_ConsumeRead( &b, 14u ) );
+    assert( qTrue == qBSBuffer_ConsumeRead( &b, 13u ) );
+    assert( qTrue == qBSBuffer_Empty( &b ) );
+
+    for( op = 0 ; op < 20000 ; op++ ){ /*random spans checked against a running sequence*/
+        n = (size_t)( rand() % 8 );
+        if( rand() & 1 ){
+            span = (qUINT8_t*)qBSBuffer_GetWriteSpan( &b, &size );
+            assert( ( NULL == span ) == ( 16u == count ) );
+            n = ( n < size )? n : size;
+            for( i = 0u ; i < n ; i++ ){
+                span[ i ] = in++;
+            }
+            assert( qTrue == qBSBuffer_CommitWrite( &b, n ) );
+            count += n;
+        }
+        else{
+            span = (qUINT8_t*)qBSBuffer_GetReadSpan( &b, &size );
+            assert( ( NULL == span ) == ( 0u == count ) );
+            n = ( n < size )? n : size;
+            for( i = 0u ; i < n ; i++ ){
+                assert( span[ i ] == out++ );
+            }
+            assert( qTrue == qBSBuffer_ConsumeRead( &b, n ) );
+            count -= n;
+        }
+        assert( count == qBSBuffer_Count( &b ) );
+    }
+}
+/*============================================================================*/
+static qQueue_t TestSPSCQueue;
+
+void* test_queuespscproducer( void *arg ){
+    qUINT32_t i;
+    (void)arg;
+    for( i = 0uL ; i < 100000uL ; ){
+        if( qTrue == qQueueSendToBack( &TestSPSCQueue, &i ) ){
+            i++;
+        }
+        else{
+            (void)sched_yield();
+        }
+    }
+    return NULL;
+}
+/*============================================================================*/
+void test_queuespsc( void ){
+    static qUINT32_t area[ 5 ];
+    qUINT32_t value, expected, src[ 8 ], dst[ 8 ], sent, received;
+    pthread_t producer;
+    size_t n, k, i;
+    int op;
+
+    assert( qTrue == qQueueCreateSPSC( &TestSPSCQueue, area, sizeof(qUINT32_t), 5u ) );
+    TestSPSCQueue.ItemsSent = TestSPSCQueue.ItemsReceived = (size_t)-2; /*the counters wrap around too*/
+    for( value = 0uL ; value < 5uL ; value++ ){
+        assert( qTrue == qQueueSendToBack( &TestSPSCQueue, &value ) );
+    }
+    assert( ( qTrue == qQueueIsFull( &TestSPSCQueue ) ) && ( 5u == qQueueCount( &TestSPSCQueue ) ) );
+    assert( qFalse == qQueueSendToBack( &TestSPSCQueue, &value ) );
+    assert( qFalse == qQueueSendToFront( &TestSPSCQueue, &value ) ); /*it would modify the consumer side*/
+    assert( ( qTrue == qQueueReceive( &TestSPSCQueue, &value ) ) && ( 0uL == value ) );
+    assert( qFalse == qQueueSendToFront( &TestSPSCQueue, &value ) );
+    sent = 5uL;
+    received = 1uL;
+    for( op = 0 ; op < 20000 ; op++ ){ /*the read and write pointers wrap at any position*/
+        n = (size_t)( rand() % 8 );
+        if( rand() & 1 ){
+            for( i = 0u ; i < n ; i++ ){
+                src[ i ] = sent + (qUINT32_t)i;
+            }
+            k = qQueueSendN( &TestSPSCQueue, src, n );
+            assert( ( k == n ) || ( qTrue == qQueueIsFull( &TestSPSCQueue ) ) );
+            sent += (qUINT32_t)k;
+        }
+        else{
+            k = qQueueReceiveN( &TestSPSCQueue, dst, n );
+            assert( ( k == n ) || ( qTrue == qQueueIsEmpty( &TestSPSCQueue ) ) );
+            for( i = 0u ; i < k ; i++ ){
+                assert( dst[ i ] == received++ );
+            }
+        }
+        assert( (size_t)( sent - received ) == qQueueCount( &TestSPSCQueue ) );
+    }
+
+    assert( qTrue == qQueueCreateSPSC( &TestSPSCQueue, area, sizeof(qUINT32_t), 5u ) ); /*a producer thread and this consumer*/
+    assert( 0 == pthread_create( &producer, NULL, test_queuespscproducer, NULL ) );
+    for( expected = 0uL ; expected < 100000uL ; ){
+        if( qTrue == qQueueReceive( &TestSPSCQueue, &value ) ){
+            assert( value == expected++ );
+        }
+        else{
+            (void)sched_yield();
+        }
+    }
+    assert( 0 == pthread_join( producer, NULL ) );
+    assert( qTrue == qQueueIsEmpty( &TestSPSCQueue ) );
+}
+/*============================================================================*/
+static qQueue_t TestQueue;
+static int TestQueueReceived[ 4 ], TestQueueN = 0;
+
+void test_queueheldcallback( qEvent_t e ){
+    int *slot = (int*)e->EventData;
+    int value = 9;
+
+    assert( byQueueReceiver == e->Trigger );
+    TestQueueReceived[ TestQueueN ] = *slot;
+    if( 0 == TestQueueN ){ /*the queue is full and its front slot is being processed in place*/
+        assert( qTrue == qQueueOverwrite( &TestQueue, &value ) ); /*replaces the newest item*/
+        assert( qFalse == qQueueSendToFront( &TestQueue, &value ) );
+        assert( ( 1 == *slot ) && ( 2u == qQueueCount( &TestQueue ) ) );
+    }
+    else if( 1 == TestQueueN ){ /*there is room again, so the overwrite goes to the back*/
+        value = 5;
+        assert( qTrue == qQueueOverwrite( &TestQueue, &value ) );
+        assert( 9 == *slot );
+    }
+    else{
+        assert( qTrue == qTaskAttachQueue( qTaskSelf(), &TestQueue, qQUEUE_RECEIVER, qDETACH ) ); /*the held slot must be released anyway*/
+        qSchedulerRelease();
+    }
+    TestQueueN++;
+}
+/*============================================================================*/
+void test_queueheld( void ){
+    static qTask_t task;
+    static int area[ 2 ];
+    int value, *slot;
+
+    assert( qTrue == qQueueCreate( &TestQueue, area, sizeof(int), 1u ) ); /*a held item alone can't be replaced*/
+    value = 1;
+    assert( qTrue == qQueueSendToBack( &TestQueue, &value ) );
+    slot = (int*)qQueuePeekSlot( &TestQueue );
+    value = 2;
+    assert( qFalse == qQueueOverwrite( &TestQueue, &value ) );
+    assert( qTrue == qQueueRelease( &TestQueue, slot ) );
+    assert( qTrue == qQueueOverwrite( &TestQueue, &value ) );
+
+    assert( qTrue == qQueueCreate( &TestQueue, area, sizeof(int), 2u ) );
+    value = 1;
+    assert( qTrue == qQueueSendToBack( &TestQueue, &value ) );
+    value = 2;
+    assert( qTrue == qQueueSendToBack( &TestQueue, &value ) );
+    qSchedulerSetup( GetTickCountMs, 0.001, NULL );
+    assert( qTrue == qSchedulerAdd_EventTask( &task, test_queueheldcallback, qHigh_Priority, NULL ) );
+    assert( qTrue == qTaskAttachQueue( &task, &TestQueue, qQUEUE_RECEIVER, qATTACH ) );
+    qSchedulerRun();
+    assert( 3 == TestQueueN );
+    assert( ( 1 == TestQueueReceived[ 0 ] ) && ( 9 == TestQueueReceived[ 1 ] ) && ( 5 == TestQueueReceived[ 2 ] ) );
+    assert( qTrue == qQueueIsEmpty( &TestQueue ) );
+    assert( qTrue == qQueueSendToFront( &TestQueue, &value ) ); /*nothing is held*/
+}
+/*============================================================================*/
+void test_pqueueheld( void ){
+    qPQueue_t q;
+    static int area[ 5 ];
+    static qPQueueEntry_t entries[ 4 ];
+    int *held[ 2 ], value, i;
+    qPriority_t prio;
+
+    assert( qTrue == qPQueueCreate( &q, area, entries, sizeof(int), 4u ) ); /*area[ 4 ] is not a slot of the queue*/
+    for( i = 0 ; i < 3 ; i++ ){
+        assert( qTrue == qPQueueSend( &q, &i, (qPriority_t)i ) );
+    }
+    held[ 0 ] = (int*)qPQueueReceiveSlot( &q );
+    held[ 1 ] = (int*)qPQueueReceiveSlot( &q );
+    assert( ( 2 == *held[ 0 ] ) && ( 1 == *held[ 1 ] ) );
+    value = 7;
+    assert( qTrue == qPQueueSend( &q, &value, 5u ) ); /*takes the last free slot*/
+    assert( qFalse == qPQueueSend( &q, &value, 5u ) ); /*the held slots can't be taken*/
+    assert( ( 2 == *held[ 0 ] ) && ( 1 == *held[ 1 ] ) );
+    assert( qFalse == qPQueueRelease( &q, &area[ 4 ] ) );
+    assert( qFalse == qPQueueRelease( &q, (qUINT8_t*)held[ 0 ] + 1 ) );
+    assert( qTrue == qPQueueRelease( &q, held[ 0 ] ) );
+    assert( qFalse == qPQueueRelease( &q, held[ 0 ] ) ); /*released twice*/
+    assert( qTrue == qPQueueRelease( &q, held[ 1 ] ) );
+    assert( ( qTrue == qPQueueReceive( &q, &value, &prio ) ) && ( 7 == value ) && ( 5u == prio ) );
+    assert( ( qTrue == qPQueueReceive( &q, &value, &prio ) ) && ( 0 == value ) );
+    assert( qTrue == qPQueueIsEmpty( &q ) );
+    assert( qFalse == qPQueueRelease( &q, &area[ 0 ] ) ); /*nothing is held*/
+}
+/*============================================================================*/
+void test_mailboxwrap( void ){
+    qMailbox_t mb;
+    static size_t area[ qMailbox_AreaWords( sizeof(int), 4 ) ];
+    size_t seq, cursor;
+    int value, item, i;
+
+    assert( qFalse == qMailbox_Create( &mb, area, sizeof(int), 3u ) ); /*not a power of two*/
+    assert( qTrue == qMailbox_Create( &mb, area, sizeof(int), 4u ) );
+    assert( qFalse == qMailbox_ReadLatest( &mb, &value, &seq ) );
+    mb.qPrivate.Posted = (size_t)-3; /*the next posts wrap the sequence around*/
+    cursor = (size_t)-3;
+    for( i = 1 ; i <= 10 ; i++ ){
+        assert( qTrue == qMailbox_Post( &mb, &i ) );
+        assert( ( qTrue == qMailbox_ReadLatest( &mb, &value, &seq ) ) && ( i == value ) && ( (size_t)( i - 3 ) == seq ) );
+        if( 0 == ( i % 3 ) ){ /*this reader keeps up, so it misses nothing*/
+            for( value = i - 2 ; qTrue == qMailbox_ReadNext( &mb, &item, &cursor ) ; value++ ){
+                assert( value == item );
+            }
+            assert( ( value == ( i + 1 ) ) && ( (size_t)( i - 3 ) == cursor ) );
+        }
+    }
+    cursor = (size_t)-5; /*a reader left behind, gets the 4 items still kept*/
+    assert( ( qTrue == qMailbox_ReadNext( &mb, &value, &cursor ) ) && ( 7 == value ) && ( 4u == cursor ) );
+}
+/*============================================================================*/
+static qMPSC_t TestMPSC;
+static testnode_t TestMPSCNodes[ 2 ][ 1000 ];
+
+void* test_mpscproducer( void *arg ){
+    testnode_t *nodes = (testnode_t*)arg;
+    int i;
+    for( i = 0 ; i < 1000 ; i++ ){
+        assert( qTrue == qMPSC_Push( &TestMPSC, &nodes[ i ] ) );
+        if( 0 == ( i % 64 ) ){
+            (void)sched_yield(); /*interleave with the other producer and the consumer*/
+        }
+    }
+    return NULL;
+}
+/*============================================================================*/
+void test_mpsc( void ){
+    testnode_t *n, nodes[ 4 ];
+    qList_t l;
+    pthread_t producer[ 2 ];
+    int i, next[ 2 ] = { 0, 0 }, taken = 0;
+
+    assert( qTrue == qMPSC_Initialize( &TestMPSC ) );
+    qList_Initialize( &l );
+    assert( ( qTrue == qMPSC_IsEmpty( &TestMPSC ) ) && ( NULL == qMPSC_PopAll( &TestMPSC ) ) );
+    for( i = 0 ; i < 4 ; i++ ){
+        nodes[ i ].container = NULL;
+        nodes[ i ].key = i;
+        assert( qTrue == qMPSC_Push( &TestMPSC, &nodes[ i ] ) );
+    }
+    assert( qFalse == qMPSC_Push( &TestMPSC, &nodes[ 2 ] ) ); /*still pending*/
+    n = (testnode_t*)qMPSC_PopAll( &TestMPSC );
+    for( i = 0 ; i < 4 ; i++ ){ /*the push order is kept*/
+        assert( ( NULL != n ) && ( i == n->key ) && ( NULL == n->container ) );
+        n = (testnode_t*)n->next;
+    }
+    assert( ( NULL == n ) && ( qTrue == qMPSC_IsEmpty( &TestMPSC ) ) );
+    assert( qTrue == qMPSC_Push( &TestMPSC, &nodes[ 2 ] ) ); /*taken, so it can go again*/
+    assert( qTrue == qMPSC_Push( &TestMPSC, &nodes[ 0 ] ) );
+    assert( qTrue == qList_Insert( &l, &nodes[ 3 ], qList_AtBack ) );
+    assert( qFalse == qMPSC_Push( &TestMPSC, &nodes[ 3 ] ) ); /*belongs to a list*/
+    assert( 2u == qMPSC_PopAllToList( &TestMPSC, &l ) );
+    assert( 3u == qList_Length( &l ) );
+    assert( 3 == ( (testnode_t*)qList_Remove( &l, NULL, qList_AtFront ) )->key );
+    assert( 2 == ( (testnode_t*)qList_Remove( &l, NULL, qList_AtFront ) )->key );
+    assert( 0 == ( (testnode_t*)qList_Remove( &l, NULL, qList_AtFront ) )->key );
+
+    for( i = 0 ; i < 2000 ; i++ ){ /*two producer threads and this consumer*/
+        TestMPSCNodes[ i / 1000 ][ i % 1000 ].container = NULL;
+        TestMPSCNodes[ i / 1000 ][ i % 1000 ].key = i / 1000;
+        TestMPSCNodes[ i / 1000 ][ i % 1000 ].seq = i % 1000;
+    }
+    assert( 0 == pthread_create( &producer[ 0 ], NULL, test_mpscproducer, TestMPSCNodes[ 0 ] ) );
+    assert( 0 == pthread_create( &producer[ 1 ], NULL, test_mpscproducer, TestMPSCNodes[ 1 ] ) );
+    while( taken < 2000 ){
+        for( n = (testnode_t*)qMPSC_PopAll( &TestMPSC ) ; NULL != n ; n = (testnode_t*)n->next ){
+            assert( next[ n->key ]++ == n->seq ); /*each producer order is kept*/
+            taken++;
+        }
+        (void)sched_yield();
+    }
+    assert( 0 == pthread_join( producer[ 0 ], NULL ) );
+    assert( 0 == pthread_join( producer[ 1 ], NULL ) );
+    assert( ( 1000 == next[ 0 ] ) && ( 1000 == next[ 1 ] ) && ( qTrue == qMPSC_IsEmpty( &TestMPSC ) ) );
+}
+/*============================================================================*/
+#define TEST_MPMC_ITEMS     ( 20000 )
+
+static qMPMC_t TestMPMC;
+static size_t TestMPMCArea[ qMPMC_AreaWords( sizeof(qUINT32_t), 8 ) ];
+static qUINT8_t TestMPMCSeen[ 2*TEST_MPMC_ITEMS ];
+static volatile size_t TestMPMCTaken;
+
+void* test_mpmcproducer( void *arg ){
+    qUINT32_t src[ 5 ], next = 0uL, base = (qUINT32_t)(size_t)arg;
+    size_t n, i;
+
+    while( next < (qUINT32_t)TEST_MPMC_ITEMS ){
+        n = 1u + (size_t)( next % 5uL );
+        for( i = 0u ; i < n ; i++ ){
+            src[ i ] = base + next + (qUINT32_t)i;
+        }
+        n = qMPMC_SendN( &TestMPMC, src, ( ( next + n ) > (qUINT32_t)TEST_MPMC_ITEMS )? 1u : n );
+        next += (qUINT32_t)n;
+        if( 0u == n ){
+            (void)sched_yield();
+        }
+    }
+    return NULL;
+}
+/*============================================================================*/
+void* test_mpmcconsumer( void *arg ){
+    qUINT32_t dst[ 3 ], last[ 2 ] = { 0uL, 0uL };
+    size_t n, i, Taken;
+
+    (void)arg;
+    while( TestMPMCTaken < ( 2u*TEST_MPMC_ITEMS ) ){
+        n = qMPMC_ReceiveN( &TestMPMC, dst, 3u );
+        for( i = 0u ; i < n ; i++ ){
+            assert( 0u == TestMPMCSeen[ dst[ i ] ] ); /*each item is received once*/
+            TestMPMCSeen[ dst[ i ] ] = 1u;
+            assert( dst[ i ] >= last[ dst[ i ]/TEST_MPMC_ITEMS ] ); /*in the order of its producer*/
+            last[ dst[ i ]/TEST_MPMC_ITEMS ] = dst[ i ] + 1uL;
+        }
+        do{
+            Taken = TestMPMCTaken;
+        }while( qFalse == qCritical_CompareAndSwapSize( &TestMPMCTaken, Taken, Taken + n ) );
+        (void)sched_yield();
+    }
+    return NULL;
+}
+/*============================================================================*/
+void test_mpmc( void ){
+    qUINT32_t src[ 10 ], dst[ 10 ], i;
+    size_t base = (size_t)-5;
+    pthread_t thread[ 4 ];
+
+    assert( qFalse == qMPMC_Create( &TestMPMC, TestMPMCArea, sizeof(qUINT32_t), 6u ) ); /*not a power of two*/
+    assert( qTrue == qMPMC_Create( &TestMPMC, TestMPMCArea, sizeof(qUINT32_t), 8u ) );
+    TestMPMC.qPrivate.EnqueuePos = TestMPMC.qPrivate.DequeuePos = base; /*the tickets wrap around too*/
+    for( i = 0uL ; i < 8uL ; i++ ){
+        TestMPMCArea[ ( ( base + i ) & 7u )*( qMPMC_SlotSize( sizeof(qUINT32_t) )/sizeof(size_t) ) ] = base + i;
+    }
+    for( i = 0uL ; i < 10uL ; i++ ){
+        src[ i ] = i;
+    }
+    assert( 6u == qMPMC_SendN( &TestMPMC, src, 6u ) );
+    assert( 4u == qMPMC_ReceiveN( &TestMPMC, dst, 4u ) );
+    assert( 6u == qMPMC_SendN( &TestMPMC, &src[ 4 ], 10u ) ); /*a batch cut by the free slots, across the end of the ring*/
+    assert( ( 8u == qMPMC_Count( &TestMPMC ) ) && ( qFalse == qMPMC_TrySend( &TestMPMC, src ) ) );
+    assert( 8u == qMPMC_ReceiveN( &TestMPMC, dst, 10u ) );
+    for( i = 0uL ; i < 8uL ; i++ ){
+        assert( dst[ i ] == ( ( i < 2uL )? ( i + 4uL ) : ( i + 2uL ) ) );
+    }
+    assert( ( 0u == qMPMC_Count( &TestMPMC ) ) && ( qFalse == qMPMC_TryReceive( &TestMPMC, dst ) ) );
+
+    assert( qTrue == qMPMC_Create( &TestMPMC, TestMPMCArea, sizeof(qUINT32_t), 8u ) ); /*two producer and two consumer threads*/
+    TestMPMCTaken = 0u;
+    assert( 0 == pthread_create( &thread[ 0 ], NULL, test_mpmcproducer, (void*)0 ) );
+    assert( 0 == pthread_create( &thread[ 1 ], NULL, test_mpmcproducer, (void*)(size_t)TEST_MPMC_ITEMS ) );
+    assert( 0 == pthread_create( &thread[ 2 ], NULL, test_mpmcconsumer, NULL ) );
+    assert( 0 == pthread_create( &thread[ 3 ], NULL, test_mpmcconsumer, NULL ) );
+    for( i = 0uL ; i < 4uL ; i++ ){
+        assert( 0 == pthread_join( thread[ i ], NULL ) );
+    }
+    assert( ( ( 2u*TEST_MPMC_ITEMS ) == TestMPMCTaken ) && ( 0u == qMPMC_Count( &TestMPMC ) ) );
+}
+/*============================================================================*/
+#if ( Q_QUEUE_SET_SIZE >= 4 )
+void test_queueset( void ){
+    static qQueueSet_t set; /*it stays in the registry of created sets*/
+    static const int expected[ 12 ] = { 0, 1, 2, 3, 0, 2, 3, 0, 3, 0, 0, 0 }; /*the busy queue can't starve the others*/
+    qQueue_t q[ 4 ], spsc, *selected;
+    static int area[ 4 ][ 8 ], spscarea[ 2 ];
+    int served[ 4 ] = { 0, 0, 0, 0 }, value, i, j;
+
+    assert( qTrue == qQueueSetCreate( &set ) );
+    assert( ( qFalse == qQueueSetIsReady( &set ) ) && ( NULL == qQueueSetSelect( &set ) ) );
+    for( i = 0 ; i < 4 ; i++ ){
+        assert( qTrue == qQueueCreate( &q[ i ], area[ i ], sizeof(int), 8u ) );
+        assert( qTrue == qQueueSetAdd( &set, &q[ i ] ) );
+    }
+    assert( qFalse == qQueueSetAdd( &set, &q[ 1 ] ) ); /*already a member*/
+    assert( qTrue == qQueueCreateSPSC( &spsc, spscarea, sizeof(int), 2u ) );
+    assert( qFalse == qQueueSetAdd( &set, &spsc ) );
+    for( i = 1 ; i < 4 ; i++ ){ /*queue <i> holds <i> items, queue 0 is kept busy*/
+        for( value = 0 ; value < i ; value++ ){
+            assert( qTrue == qQueueSendToBack( &q[ i ], &value ) );
+        }
+    }
+    value = 0;
+    assert( qTrue == qQueueSendToBack( &q[ 0 ], &value ) );
+    assert( qTrue == qQueueSetIsReady( &set ) );
+    for( j = 0 ; j < 12 ; j++ ){
+        selected = qQueueSetSelect( &set );
+        assert( NULL != selected );
+        i = (int)( selected - q );
+        assert( expected[ j ] == i );
+        served[ i ]++;
+        assert( qTrue == qQueueReceive( selected, &value ) );
+        if( 0 == i ){
+            assert( qTrue == qQueueSendToBack( &q[ 0 ], &value ) ); /*never empty*/
+        }
+    }
+    assert( ( 1 == served[ 1 ] ) && ( 2 == served[ 2 ] ) && ( 3 == served[ 3 ] ) );
+    for( j = 0 ; j < 4 ; j++ ){ /*only the busy queue holds items*/
+        assert( &q[ 0 ] == qQueueSetSelect( &set ) );
+    }
+    assert( qTrue == qQueueSetRemove( &set, &q[ 0 ] ) );
+    assert( ( qFalse == qQueueSetIsReady( &set ) ) && ( NULL == qQueueSetSelect( &set ) ) );
+    assert( qFalse == qQueueSetRemove( &set, &q[ 0 ] ) );
+    assert( qTrue == qQueueSendToBack( &q[ 2 ], &value ) );
+    assert( qTrue == qQueueCreate( &q[ 2 ], area[ 2 ], sizeof(int), 8u ) ); /*re-created, so it leaves the set*/
+    assert( qTrue == qQueueSendToBack( &q[ 2 ], &value ) );
+    assert( ( qFalse == qQueueSetIsReady( &set ) ) && ( qTrue == qQueueSetAdd( &set, &q[ 0 ] ) ) );
+    assert( &q[ 0 ] == qQueueSetSelect( &set ) );
+    for( i = 0 ; i < 4 ; i++ ){
+        (void)qQueueSetRemove( &set, &q[ i ] ); /*on the stack, they must leave the set before returning*/
+    }
+}
+#endif
+/*============================================================================*/
+#if ( Q_LIST_POOLS == 1 )
+void test_listpool( void ){
+    qListPool_t pool, other;
+    static qUINT8_t area[ 1024 ], otherarea[ 256 ];
+    void *blocks[ 64 ], *b;
+    size_t n, i, j;
+
+    assert( qTrue == qListPool_Setup( &pool, sizeof(testnode_t), area, sizeof(area) ) );
+    assert( qTrue == qListPool_Setup( &other, sizeof(testnode_t), otherarea, sizeof(otherarea) ) );
+    n = 0u;
+    while( ( n < 64u ) && ( NULL != ( b = qListPool_Alloc( &pool ) ) ) ){ /*drain the pool*/
+        blocks[ n++ ] = b;
+    }
+    assert( ( n == qListPool_Capacity( &pool ) ) && ( n == qListPool_Used( &pool ) ) );
+    for( i = 0u ; i < n ; i++ ){
+        for( j = i + 1u ; j < n ; j++ ){
+            assert( blocks[ i ] != blocks[ j ] );
+        }
+    }
+    assert( qFalse == qListPool_Free( &other, blocks[ 0 ] ) ); /*belongs to another pool*/
+    assert( qTrue == qListPool_Free( &pool, blocks[ 0 ] ) );
+    assert( qFalse == qListPool_Free( &pool, blocks[ 0 ] ) ); /*double free*/
+    assert( ( n - 1u ) == qListPool_Used( &pool ) );
+    b = qListPool_Alloc( &pool );
+    assert( ( blocks[ 0 ] == b ) && ( NULL == qListPool_Alloc( &pool ) ) ); /*the block was queued once*/
+    for( i = 0u ; i < n ; i++ ){
+        assert( qTrue == qListPool_Free( &pool, blocks[ i ] ) );
+    }
+    assert( ( 0u == qListPool_Used( &pool ) ) && ( n == qListPool_HighWater( &pool ) ) );
+}
+#endif
+/*============================================================================*/
+#if ( Q_QUEUE_STATS == 1 )
+static int TestStatsVisits;
+
+void test_queuestatsvisit( const qQueue_t * const Queue, const char *Name, const qQueueStats_t * const Stats, void *arg ){
+    (void)Queue;
+    TestStatsVisits++;
+    if( 0 == strcmp( Name, "a" ) ){
+        *( (qQueueStats_t*)arg ) = *Stats;
+    }
+}
+/*============================================================================*/
+int test_queuestatscount( qQueueStats_t *a ){
+    TestStatsVisits = 0;
+    qQueueForEachStats( test_queuestatsvisit, a );
+    return TestStatsVisits;
+}
+/*============================================================================*/
+void test_queuestats( void ){
+    qQueue_t qa, qb; /*on the stack, they must leave the registry before returning*/
+    int areaa[ 3 ], areab[ 3 ], tmp[ 3 ], value;
+    qQueueStats_t stats;
+
+    assert( qTrue == qQueueCreate( &qa, areaa, sizeof(int), 3u ) );
+    assert( qTrue == qQueueCreate( &qb, areab, sizeof(int), 3u ) );
+    assert( qTrue == qQueueRegisterStats( &qa, "a", NULL ) );
+    assert( qTrue == qQueueRegisterStats( &qb, "b", NULL ) );
+    assert( qTrue == qQueueRegisterStats( &qa, "a", NULL ) ); /*registered once*/
+    assert( 2 == test_queuestatscount( &stats ) );
+    for( value = 0 ; value < 4 ; value++ ){
+        assert( ( value < 3 ) == qQueueSendToBack( &qa, &value ) );
+    }
+    assert( qTrue == qQueueOverwrite( &qa, &value ) );
+    assert( 3u == qQueueReceiveN( &qa, tmp, 3u ) );
+    assert( 2 == test_queuestatscount( &stats ) );
+    assert( ( 4uL == stats.TotalItems ) && ( 3u == stats.HighWater ) && ( 1u == stats.SendFailures ) && ( 1u == stats.Dropped ) );
+
+    assert( qTrue == qQueueCreate( &qb, areab, sizeof(int), 3u ) ); /*re-created, so it leaves the registry*/
+    assert( 1 == test_queuestatscount( &stats ) );
+    assert( qFalse == qQueueUnregisterStats( &qb ) );
+    assert( qTrue == qQueueRegisterStats( &qb, "b", NULL ) );
+    assert( qTrue == qQueueUnregisterStats( &qb ) );
+    assert( qTrue == qQueueUnregisterStats( &qa ) );
+    assert( 0 == test_queuestatscount( &stats ) );
+}
+#endif
+/*============================================================================*/
+#if ( Q_CHANNELS == 1 )
+static qChannel_t TestChannel;
+static int TestChannelWakeups = 0;
+
+void test_channelwakeup( void *arg ){
+    (void)arg;
+    TestChannelWakeups++;
+}
+/*============================================================================*/
+void* test_channelproducer( void *arg ){
+    qUINT32_t i;
+    (void)arg;
+    for( i = 0uL ; i < 200000uL ; ){
+        if( qTrue == qChannelSend( &TestChannel, &i ) ){
+            i++;
+        }
+        else{
+            (void)sched_yield(); /*let the consumer run, even on a single core*/
+        }
+    }
+    return NULL;
+}
+/*============================================================================*/
+void test_channel( void ){
+    static qUINT16_t area[ 5 ], src[ 16 ], dst[ 16 ];
+    static qUINT32_t area32[ 7 ];
+    qUINT16_t sent = 0u, received = 0u, value;
+    qUINT32_t item, expected;
+    pthread_t producer;
+    size_t n, i, k;
+    int op;
+
+    assert( qTrue == qChannelCreate( &TestChannel, area, sizeof(qUINT16_t), 5u ) );
+    qChannelSetWakeup( &TestChannel, test_channelwakeup, NULL );
+    for( value = 0u ; value < 5u ; value++ ){
+        assert( qTrue == qChannelSend( &TestChannel, &value ) );
+    }
+    assert( ( qTrue == qChannelIsFull( &TestChannel ) ) && ( 5u == qChannelCount( &TestChannel ) ) );
+    assert( qFalse == qChannelSend( &TestChannel, &value ) ); /*full, the oldest item is kept*/
+    assert( ( 0u == *(qUINT16_t*)qChannelPeek( &TestChannel ) ) && ( 5 == TestChannelWakeups ) );
+    assert( 5u == qChannelReceiveN( &TestChannel, dst, 16u ) );
+    for( i = 0u ; i < 5u ; i++ ){
+        assert( dst[ i ] == i );
+    }
+    assert( ( qTrue == qChannelIsEmpty( &TestChannel ) ) && ( qFalse == qChannelReceive( &TestChannel, &value ) ) );
+    qChannelSetWakeup( &TestChannel, NULL, NULL );
+    sent = received = 5u;
+    for( op = 0 ; op < 20000 ; op++ ){ /*the indexes wrap around at any position*/
+        n = (size_t)( rand() % 8 );
+        if( rand() & 1 ){
+            for( i = 0u ; i < n ; i++ ){
+                src[ i ] = (qUINT16_t)( sent + i );
+            }
+            k = qChannelSendN( &TestChannel, src, n );
+            assert( ( k == n ) || ( qTrue == qChannelIsFull( &TestChannel ) ) );
+            sent = (qUINT16_t)( sent + k );
+        }
+        else{
+            k = qChannelReceiveN( &TestChannel, dst, n );
+            assert( ( k == n ) || ( qTrue == qChannelIsEmpty( &TestChannel ) ) );
+            for( i = 0u ; i < k ; i++ ){
+                assert( dst[ i ] == received++ );
+            }
+        }
+        assert( (size_t)(qUINT16_t)( sent - received ) == qChannelCount( &TestChannel ) );
+    }
+
+    assert( qTrue == qChannelCreate( &TestChannel, area32, sizeof(qUINT32_t), 7u ) ); /*a producer thread and this consumer*/
+    assert( 0 == pthread_create( &producer, NULL, test_channelproducer, NULL ) );
+    for( expected = 0uL ; expected < 200000uL ; ){
+        if( qTrue == qChannelReceive( &TestChannel, &item ) ){
+            assert( item == expected++ );
+        }
+        else{
+            (void)sched_yield();
+        }
+    }
+    assert( 0 == pthread_join( producer, NULL ) );
+    assert( qTrue == qChannelIsEmpty( &TestChannel ) );
+}
+#endif
+/*============================================================================*/
+#if ( Q_SCHEDULER_LOAD == 1 )
+static qTask_t TestLoadA, TestLoadB;
+static qClock_t TestLoadNow = 0uL;
+static int TestLoadCalls = 0;
+
+qClock_t test_loadcounter( void ){ /*only moves inside the callbacks, so the scheduler costs nothing*/
+    return TestLoadNow;
+}
+/*============================================================================*/
+qClock_t test_loadcounter2( void ){ /*another counter, unrelated to the first one*/
+    return 3000000uL + ( 2uL*TestLoadNow );
+}
+/*============================================================================*/
+void test_loadtask( qEvent_t e ){
+    (void)e;
+    if( &TestLoadA == qTaskSelf() ){
+        TestLoadNow += 30uL;
+        if( TestLoadCalls > 100 ){ /*any window latched after the restart is sane*/
+            assert( qTaskGetLoad( &TestLoadB ) <= 250u );
+        }
+    }
+    else{
+        TestLoadNow += 10uL;
+        TestLoadCalls++;
+        if( 100 == TestLoadCalls ){
+            assert( ( 750u == qTaskGetLoad( &TestLoadA ) ) && ( 250u == qTaskGetLoad( &TestLoadB ) ) );
+            assert( ( 0uL != TestLoadA.qPrivate.BusyTime ) && ( 0uL != TestLoadB.qPrivate.BusyTime ) );
+            qSchedulerSetLoadCounter( test_loadcounter2, 2000uL );
+            assert( ( 0uL == TestLoadA.qPrivate.BusyTime ) && ( 0uL == TestLoadB.qPrivate.BusyTime ) ); /*every task starts again*/
+        }
+        else if( 200 == TestLoadCalls ){
+            assert( ( 750u == qTaskGetLoad( &TestLoadA ) ) && ( 250u == qTaskGetLoad( &TestLoadB ) ) );
+            qSchedulerRelease();
+        }
+        else{
+            /*nothing to do*/
+        }
+    }
+}
+/*============================================================================*/
+void test_schedulerload( void ){
+    qLoad_t detail;
+
+    qSchedulerSetup( GetTickCountMs, 0.001, NULL );
+    qSchedulerSetLoadCounter( test_loadcounter, 1000uL );
+    assert( qTrue == qSchedulerAdd_Task( &TestLoadA, test_loadtask, qHigh_Priority, qTimeImmediate, qPeriodic, qEnabled, NULL ) );
+    assert( qTrue == qSchedulerAdd_Task( &TestLoadB, test_loadtask, qLowest_Priority, qTimeImmediate, qPeriodic, qEnabled, NULL ) );
+    qSchedulerRun();
+    assert( 1000u == qSchedulerGetLoad( &detail ) );
+    assert( ( 1000u == detail.Tasks ) && ( 0u == detail.Idle ) );
+    assert( qTrue == qSchedulerRemoveTask( &TestLoadA ) );
+    assert( qTrue == qSchedulerRemoveTask( &TestLoadB ) );
+}
+#endif
+/*============================================================================*/
+#if ( Q_REPLAY == 1 )
+typedef struct{
+    qTask_t *Task;
+    qTrigger_t Trigger;
+    qClock_t Tick;
+    int Data;
+}testreplaylog_t;
+
+static qTask_t TestReplayTimed, TestReplayEvent;
+static qQueue_t TestReplayQueue;
+static int TestReplayData = 42;
+static qClock_t TestReplayNow;
+static qUINT8_t TestReplayStream[ 4096 ];
+static size_t TestReplayLength, TestReplayPosition;
+static testreplaylog_t TestReplayLog[ 2 ][ 256 ];
+static int TestReplayCount[ 2 ], TestReplayPass;
+
+qClock_t test_replaytick( void ){ /*a fake clock that also plays the interrupts*/
+    int value;
+
+    TestReplayNow++;
+    if( qReplay_Recording == qReplay_GetState() ){ /*while replaying, these inputs come from the stream*/
+        if( 0uL == ( TestReplayNow % 7uL ) ){
+            (void)qReplay_SendNotificationFromISR( &TestReplayEvent, &TestReplayData );
+        }
+        if( 0uL == ( TestReplayNow % 11uL ) ){
+            value = (int)TestReplayNow;
+            (void)qReplay_QueueSendFromISR( &TestReplayQueue, &value, QUEUE_SEND_TO_BACK );
+        }
+    }
+    return TestReplayNow;
+}
+/*============================================================================*/
+void test_replaywrite( const void *src, size_t n, void *arg ){
+    (void)arg;
+    assert( ( TestReplayLength + n ) <= sizeof(TestReplayStream) );
+    memcpy( &TestReplayStream[ TestReplayLength ], src, n );
+    TestReplayLength += n;
+}
+/*============================================================================*/
+size_t test_replayread( void *dst, size_t n, void *arg ){
+    (void)arg;
+    if( n > ( TestReplayLength - TestReplayPosition ) ){
+        n = TestReplayLength - TestReplayPosition;
+    }
+    memcpy( dst, &TestReplayStream[ TestReplayPosition ], n );
+    TestReplayPosition += n;
+    return n;
+}
+/*============================================================================*/
+void test_replaytask( qEvent_t e ){
+    testreplaylog_t *entry;
+
+    assert( TestReplayCount[ TestReplayPass ] < 256 );
+    entry = &TestReplayLog[ TestReplayPass ][ TestReplayCount[ TestReplayPass ]++ ];
+    entry->Task = qTaskSelf();
+    entry->Trigger = e->Trigger;
+    entry->Tick = qClock_GetTick();
+    entry->Data = ( NULL != e->EventData )? *(int*)e->EventData : -1;
+    if( ( &TestReplayTimed == entry->Task ) && ( qTrue == e->LastIteration ) ){
+        qSchedulerRelease();
+    }
+}
+/*============================================================================*/
+void test_replayrun( int pass ){
+    static int area[ 4 ];
+
+    TestReplayPass = pass;
+    TestReplayCount[ pass ] = 0;
+    TestReplayNow = 0uL;
+    assert( qTrue == qQueueCreate( &TestReplayQueue, area, sizeof(int), 4u ) );
+    qSchedulerSetup( test_replaytick, 0.001, NULL );
+    assert( qTrue == qSchedulerAdd_Task( &TestReplayTimed, test_replaytask, qLowest_Priority, 0.01, 20, qEnabled, NULL ) );
+    assert( qTrue == qSchedulerAdd_EventTask( &TestReplayEvent, test_replaytask, qHigh_Priority, NULL ) );
+    assert( qTrue == qTaskAttachQueue( &TestReplayEvent, &TestReplayQueue, qQUEUE_RECEIVER, qATTACH ) );
+    if( 0 == pass ){
+        TestReplayLength = 0u;
+        assert( qTrue == qReplay_StartRecording( test_replaywrite, NULL ) );
+    }
+    else{
+        TestReplayPosition = 0u;
+        assert( qTrue == qReplay_StartReplay( test_replayread, NULL ) );
+    }
+    qSchedulerRun();
+    qReplay_Stop();
+    assert( qTrue == qSchedulerRemoveTask( &TestReplayTimed ) ); /*so the next pass can add them again*/
+    assert( qTrue == qSchedulerRemoveTask( &TestReplayEvent ) );
+}
+/*============================================================================*/
+void test_replay( void ){
+    int i, notified = 0, queued = 0;
+
+    (void)qReplay_Register( &TestReplayTimed ); /*the registry can't be cleared, so only the first call adds them*/
+    (void)qReplay_Register( &TestReplayEvent );
+    (void)qReplay_Register( &TestReplayQueue );
+    (void)qReplay_Register( &TestReplayData );
+    test_replayrun( 0 );
+    test_replayrun( 1 );
+    assert( TestReplayCount[ 0 ] == TestReplayCount[ 1 ] );
+    for( i = 0 ; i < TestReplayCount[ 0 ] ; i++ ){
+        assert( TestReplayLog[ 0 ][ i ].Task == TestReplayLog[ 1 ][ i ].Task );
+        assert( TestReplayLog[ 0 ][ i ].Trigger == TestReplayLog[ 1 ][ i ].Trigger );
+        assert( TestReplayLog[ 0 ][ i ].Tick == TestReplayLog[ 1 ][ i ].Tick );
+        assert( TestReplayLog[ 0 ][ i ].Data == TestReplayLog[ 1 ][ i ].Data );
+        notified += ( byNotificationSimple == TestReplayLog[ 0 ][ i ].Trigger );
+        queued += ( byQueueReceiver == TestReplayLog[ 0 ][ i ].Trigger );
+    }
+    assert( ( notified > 0 ) && ( queued > 0 ) ); /*both kinds of inputs took part*/
+    printf( "qReplay: %d events replayed from a %u bytes stream\r\n", TestReplayCount[ 0 ], (unsigned)TestReplayLength );
+}
+#endif
+/*============================================================================*/
+void test_run( void ){
+    srand( 1234u );
+    test_listsort();
+    test_listiterate();
+    test_listsplice();
+    test_listinsertsorted();
+    #if ( Q_LIST_INDEX_LEVELS > 0 )
+        test_listindex();
+    #endif
+    test_hashmap();
+    test_tree();
+    test_queuebulk();
+    test_bsbuffer();
+    test_bsbufferspan();
+    test_queuespsc();
+    test_queueheld();
+    test_pqueueheld();
+    test_mailboxwrap();
+    test_mpsc();
+    test_mpmc();
+    #if ( Q_QUEUE_SET_SIZE >= 4 )
+        test_queueset();
+    #endif
+    #if ( Q_LIST_POOLS == 1 )
+        test_listpool();
+    #endif
+    #if ( Q_QUEUE_STATS == 1 )
+        test_queuestats();
+    #endif
+    #if ( Q_CHANNELS == 1 )
+        test_channel();
+    #endif
+    #if ( Q_SCHEDULER_LOAD == 1 )
+        test_schedulerload();
+    #endif
+    #if ( Q_REPLAY == 1 )
+        test_replay();
+    #endif
+    puts( "self-tests passed" );
+}
 int main(int argc, char** argv) {
        
     qQueue_t somequeue;
@@ -274,6 +1783,7 @@ int main(int argc, char** argv) {
     n9.value = 8;
 
     qSetDebugFcn(putcharfcn); 
+    test_run();
 
     qList_Initialize( &mylist );
     qList_Initialize( &otherlist ); 